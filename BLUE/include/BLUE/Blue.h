@@ -18,6 +18,8 @@
 #pragma once
 
 #include "TMatrixD.h"
+#include "TMatrixDSym.h"
+#include "TDecompChol.h"
 #include "TLatex.h"
 #include "TDatime.h"
  
@@ -145,6 +147,7 @@ public:
 
   Int_t GetCovRes(TMatrixD *const UseCovRes) const;
   Int_t GetCovRes(Double_t *const RetCovRes) const;
+  Int_t GetCovRes(const Int_t k, TMatrixD *const UseCovRes) const;
   Int_t GetRhoRes(TMatrixD *const UseRhoRes) const;
   Int_t GetRhoRes(Double_t *const RetRhoRes) const;
   Int_t GetWeight(TMatrixD *const UseWeight) const;
@@ -157,13 +160,30 @@ public:
   Int_t GetCompatObs(TMatrixD *const UseCompatObs) const;
   Int_t GetCompatObs(Double_t *const RetCompatObs) const;
 
+  // The derivatives of the (InpObs) results and of the (InpObs*InpObs)
+  // covariance of the results with respect to the InpUnc correlations,
+  // followed by the InpEst*InpUnc uncertainties (column InpUnc+i*InpUnc+k)
+  Int_t GetNumJac() const;
+  Int_t GetJacVal(TMatrixD *const UseJacVal) const;
+  Int_t GetJacVal(Double_t *const RetJacVal) const;
+  Int_t GetJacCov(TMatrixD *const UseJacCov) const;
+  Int_t GetJacCov(Double_t *const RetJacCov) const;
+
   // For InspectLike
   Int_t GetInspectLike(TMatrixD *const UseInsLik) const;
   Int_t GetInspectLike(Double_t *const RetInsLik) const;
 
   // After SolveXXX()
+  // The number of iterations and the largest relative change in % of the
+  // results per iteration of SolveRelUnc
+  Int_t GetNumRelUnc() const;
+  Int_t GetResRelUnc(TVectorD *const UseResRel) const;
+
   Int_t GetAccImpLasEst(const Int_t n) const;
   Int_t GetAccImpIndEst(const Int_t n, Int_t *const IndEst) const;
+  // The (InpEst,InpObs) results when leaving out estimate i, the uncertainty
+  // is -1 if i is the only estimate of observable n
+  Int_t GetAccImpLeaOut(TMatrixD *const UseVal, TMatrixD *const UseUnc) const;
 
   Int_t GetNumScaFac() const;
   Int_t GetNumScaRho() const;
@@ -207,6 +227,21 @@ public:
   void SetNotRelUnc();
   void SetNotRelUnc(const Int_t k);
 
+  //----------------------------------------------------------------------------
+  // Control SolveRelUnc
+  //----------------------------------------------------------------------------
+  void SetAccRelUnc(const Int_t n);
+
+  //----------------------------------------------------------------------------
+  // Control SolveScaSta
+  //----------------------------------------------------------------------------
+  void SetNumSim(const Int_t n);
+  void SetSeeSim(const Int_t IniSee);
+  // SolveScaSta() and SolveScaRho() use NumThr threads (all cores by
+  // default). They do not enable the thread safety of ROOT themselves:
+  // call ROOT::EnableThreadSafety() once, e.g. in main, or SetNumThr(1)
+  void SetNumThr(const Int_t n);
+
   //----------------------------------------------------------------------------
   // Control Printout
   //----------------------------------------------------------------------------
@@ -222,6 +257,10 @@ public:
 		 const TString ForPul, const TString ForChi,
 		 const TString ForUni);
 
+  // Keep the ROOT style of the caller. The style is no longer set up by
+  // FixInp, but by the first graphics of PrintCompatEst, PrintScaRho,
+  // PrintScaSta, DrawSens or InspectLike, so this must be called before
+  // them, and is ignored afterwards. Solving never touches the ROOT style.
   void SetNoRootSetup();
   void SetLogo(const  TString LogNam, const  TString LogVer, 
 	       const    Int_t LogCol);
@@ -290,6 +329,7 @@ public:
   void PrintWeight() const;
   void PrintResult() const; 
   void PrintCompatObs() const;
+  void PrintJacobian() const;
 
   void PrintChiPro() const;
 
@@ -297,6 +337,7 @@ public:
 
   // After SolveXXX()
   void PrintAccImp() const;
+  void PrintAccImpLeaOut() const;
   void PrintScaRho() const;
   void PrintScaRho(const TString FilNam) const;
   void PrintInfWei() const;
@@ -490,6 +531,12 @@ private:
   static const Int_t MaxCof = 3;
   TMatrixD* Cof;
 
+  // Depth of the Anderson acceleration and history of SolveRelUnc
+  static const Int_t MaxRelUnc = 200;
+  Int_t     AndRelUnc;
+  Int_t     NumRelUnc;
+  TVectorD* ResRelUnc;
+
   // The list of importance of estimates for SolveAccImp == abs(weight) 
   Double_t  PreAcc;
   Int_t     IntAcc;
@@ -500,16 +547,13 @@ private:
   TMatrixD* UncImp;
   TMatrixD* StaImp;
   TMatrixD* SysImp;
+  TMatrixD* ValLea;
+  TMatrixD* UncLea;
 
-  // Structures to allow for a simulation
-  TVectorD* XvaSimu;
-  TMatrixD* UncSimu;
-  TMatrixD* CorSimu;
- 
   // Structure for SolveScaSta
   Int_t  StaFla;
   static const Int_t StaPar = 6;
-  static const Int_t NumSim = 1000;
+  Int_t  NumSim;
   TMatrixD* ValResSimu;
   TMatrixD* UncResSimu;
   TMatrixD* StaResSimu;
@@ -544,8 +588,8 @@ private:
   // Control flag for print out level
   Int_t IPrint;
 
-  // Control flag for SetNoRootSetup
-  Int_t IndRoo;
+  // Control flag for SetNoRootSetup, set by the first graphics
+  mutable Int_t IndRoo;
 
   // Variables for Logo
   static const Int_t EmbDim = 2;
@@ -571,10 +615,10 @@ private:
 
   // Save harbor for all input
   Int_t     InpEstOrig, InpUncOrig, InpObsOrig;
-  TVectorD* XvaOrig;
-  TVectorD* SigOrig;
-  TMatrixD* UncOrig;
-  TMatrixD* CorOrig;
+  TVectorD*  XvaOrig;
+  TVectorD*  SigOrig;
+  TMatrixD*  UncOrig;
+  TMatrixD** CorOrig;
   TMatrixD* UmaOrig;
   TMatrixD* UtrOrig;
   TMatrixD* StaOrig;
@@ -590,8 +634,12 @@ private:
   TVectorD* Sig;
 
   // Matrices to do the job
-  TMatrixD* Unc;
-  TMatrixD* Cor;
+  // The uncertainties are stored per source: Unc(i,k) is the uncertainty
+  // of estimate i due to source k, and Cor[k] is the (InpEst,InpEst)
+  // correlation matrix of source k. The same holds for the Orig
+  // structures, with the dimensions of all inputs.
+  TMatrixD*  Unc;
+  TMatrixD** Cor;
   TMatrixD* Cov;
   TMatrixD* CovI;
   TMatrixD* Rho;
@@ -608,6 +656,33 @@ private:
   TMatrixD* CovRes;
   TMatrixD* RhoRes;
 
+  // Derivatives of the results, computed by CalcJacobian() on the first
+  // request after Solve() and kept until the next SetIsSolved(). They are
+  // mutable, since the const getters fill them.
+  mutable Int_t IsJacRes;
+  mutable TMatrixD* JacValRes;
+  mutable TMatrixD* JacCovRes;
+
+  // Workspace of FixInp, Solve and CalcInvert, named as in Solve. It is
+  // allocated once and only resized by ResizeWork if the number of active
+  // estimates (WrkEst) or observables (WrkObs) changes. WrkSym and WrkChl
+  // are mutable, since the const methods invert their matrices in them, so
+  // these methods are not reentrant either (see CalcInvert).
+  Int_t WrkEst;
+  Int_t WrkObs;
+  TMatrixD* WrkCor;
+  TMatrixD* WrkH;
+  TMatrixD* WrkI;
+  TMatrixD* WrkJ;
+  TMatrixD* WrkK;
+  TMatrixD* WrkL;
+  TMatrixD* WrkM;
+  TMatrixD* WrkN;
+  TMatrixD* WrkO;
+  TMatrixD* WrkP;
+  mutable TMatrixDSym* WrkSym[2];
+  mutable TDecompChol* WrkChl[2];
+
   // Chiq information of the results
   Double_t ChiQua;
   Double_t ChiPro;
@@ -645,6 +720,8 @@ private:
 
   // Variables for the simulation
   Int_t IsSeeded;
+  Int_t SimSee;
+  Int_t NumThr;
 
 private:
   //----------------------------------------------------------------------------
@@ -657,13 +734,15 @@ private:
   //----------------------------------------------------------------------------
   void Construct(const Int_t NumEst, const Int_t NumUnc, const Int_t NumObs, 
 		 const Int_t *const IntObs, const Int_t *const IntFac);
-  void SetupRoot();
+  void SetupRoot() const;
 
   //----------------------------------------------------------------------------
   // Solver
   //----------------------------------------------------------------------------
   void SolveScaRho(const Int_t RhoFla, const TMatrixD *const MinFac, 
 		   const TMatrixD *const MaxFac);
+  Int_t SolveScaRhoInc(const Int_t RhoFla, const TMatrixD *const MinFac, 
+		       const TMatrixD *const MaxFac);
 
   void SetIsSolved(const Int_t l);
   void SetIsSolvedRelUnc(const Int_t l);
@@ -681,8 +760,11 @@ private:
   //----------------------------------------------------------------------------
   // Fillers
   //----------------------------------------------------------------------------
+  void ResizeWork();
   void FillCov();
+  void FillCovSource(const Int_t k, TMatrixD *const CovK) const;
   void FillCovInvert();
+  Int_t FillRelUnc();
   void FillSig();
   void FillRho();
 
@@ -797,6 +879,14 @@ private:
 		      const Double_t *const par) const;
   void     CalcChiRes(const Int_t n, const Int_t IsLike,
 		      const Double_t xt) const;
+  void     CalcJacobian() const;
+  void     CalcLikScan(const Int_t n, const Int_t IsLike,
+		       const Double_t xlow, const Double_t xste,
+		       const Int_t nste, Double_t *const LogLik) const;
+  Int_t    CalcLikInt(const Double_t *const LogLik, const Int_t nste,
+		      const Double_t xlow, const Double_t xste,
+		      Double_t *const xmax, Double_t *const LogMin,
+		      Double_t *const xdow, Double_t *const xupp) const;
 
   void CalcParams();
 
@@ -811,6 +901,24 @@ private:
 
   Int_t IsWhichMatrix(const TMatrixD *const TryMat) const;
 
+  // Invert in the shared workspace WrkSym/WrkChl, which is overwritten, so
+  // it must not be called from several threads at the same time. Only the
+  // second overload, with a workspace of the caller, is reentrant.
+  Int_t CalcInvert(const TMatrixD *const InpMat, TMatrixD *const OutMat,
+		   const TString Caller, Double_t *const Det = NULL) const;
+  Int_t CalcInvert(const TMatrixD *const InpMat, TMatrixD *const OutMat,
+		   TMatrixDSym *const SymMat, TDecompChol *const Chol,
+		   const TString Caller, Double_t *const Det = NULL) const;
+
+  // Rank-one updates of the inverse covariance for SolveAccImp and SolvePosWei
+  Int_t CalcInvDel(TMatrixD *const InvMat, Int_t *const Act,
+		   const Int_t j, TMatrixD *const WrkVec) const;
+  Int_t CalcInvAdd(TMatrixD *const InvMat, Int_t *const Act,
+		   const Int_t j, TMatrixD *const WrkVec) const;
+  void CalcInvAct(TMatrixD *const InvMat, const Int_t *const Act) const;
+  void CalcSolveInv(const TMatrixD *const InvMat, TMatrixD *const HMat,
+		    TMatrixD *const CovMat, TMatrixD *const LamMat) const;
+
   void MatrixtoDouble(const TMatrixD *const InpMat, 
 		            Double_t *const OutDou) const;
 
@@ -819,6 +927,7 @@ private:
 
   // Simulation of changed estimates or uncertainties 
   void SimulInit(const Int_t IniSee);
+  UInt_t SimulSeed(const Int_t N) const;
 
   //----------------------------------------------------------------------------
   // Display
@@ -0,0 +1,17 @@
+/**
+ * Charm Combination
+ * Author: tommaso.pajero@cern.ch
+ * Date: October 2026
+ *
+ * Estimates and combinations of DeltaY (a.k.a. -A_Gamma) measurements, run by the executable `dy` and used in-process
+ * by the charm fitter (see PDF_BLUE). Values are expressed in units of 10^-4.
+ */
+
+#pragma once
+
+#include <BLUE/Utils.h>
+
+namespace BLUE::dy {
+  /// Estimates, names of observables and uncertainties, correlations and combinations of DeltaY measurements.
+  const Inputs& inputs();
+}  // namespace BLUE::dy
@@ -1,10 +1,11 @@
 #pragma once
 
+#include <TMatrixDSym.h>
 #include <TString.h>
 
+#include <filesystem>
 #include <map>
 #include <string>
-#include <utility>
 #include <vector>
 
 namespace BLUE {
@@ -15,20 +16,52 @@ namespace BLUE {
    * - its statistical uncertainty;
    * - the systematic uncertainties (uncertainties that are correlated between different estimates must be listed
    *   separately).
+   *
+   * The index `obs` selects the measured observable in `names_obs` (see `run_combination`).
    */
   struct Estimate {
     std::string name;
     std::vector<double> vals;
+    int obs = 0;
   };
 
   using Estimates = std::vector<Estimate>;
 
-  /// Named combination: human-readable title plus the names of active estimates.
-  using Combination = std::pair<std::string, std::vector<std::string>>;
+  /**
+   * Named combination: human-readable title plus the names of active estimates.
+   *
+   * By default all estimates are averaged as measurements of the first observable. With `multi_obs`, each estimate
+   * measures the observable `Estimate::obs`, and all observables are averaged at once, with their full correlations.
+   */
+  struct Combination {
+    std::string title;
+    std::vector<std::string> inputs;
+    bool multi_obs = false;
+  };
 
   /// Map combining integer flags to named combinations.
   using Combinations = std::map<int, Combination>;
 
+  /// Full definition of the combinations of one set of estimates, with the arguments of `run_combination`.
+  struct Inputs {
+    Estimates estimates;
+    std::vector<TString> names_obs;
+    std::vector<TString> names_unc;
+    std::vector<double> rho;
+    Combinations combinations;
+  };
+
+  /**
+   * Averaged observables of one combination, with the statistical covariance (from the first uncertainty source) and
+   * the systematic covariance (summed over all other sources).
+   */
+  struct Average {
+    std::vector<std::string> observables;  ///< Names of the averaged observables, in the order of `names_obs`.
+    std::vector<double> values;
+    TMatrixDSym cov_stat;
+    TMatrixDSym cov_syst;
+  };
+
   struct OutputFormat {
     TString for_val = "%+4.2f";
     TString for_unc = "%2.2f";
@@ -39,24 +72,33 @@ namespace BLUE {
     TString for_uni = "";
   };
 
+  /// Options of the BLUE executables.
+  struct Options {
+    std::vector<int> flags;        ///< Flags of the combinations to be run, in order.
+    std::filesystem::path output;  ///< JSON file for the results, if not empty.
+    bool jacobian = false;         ///< Print the derivatives of the results (see Blue::PrintJacobian).
+  };
+
   /**
    * Parse the arguments of the main function of BLUE executables.
    *
-   * Looks for a single integer argument, which is interpreted as the combination flag, and for the "-h" or "--help",
-   * which instead prints all available combinations, including flag, title, and the names of the measurements that
-   * it includes.
+   * Looks for one or more integer arguments, which are interpreted as the combination flags, or for "--all", which
+   * selects all combinations, for "--output <file>", which writes the results to a JSON file (see
+   * `run_combination`), and for "--jacobian", which prints the derivatives of each result with respect to the
+   * correlations and uncertainties of the inputs. The "-h" or "--help" option instead prints all available
+   * combinations, including flag, title, and the names of the measurements that it includes.
    */
-  int parse_args(int argc, char** argv, const Combinations& combinations);
+  Options parse_args(int argc, char** argv, const Combinations& combinations);
 
   /**
-   * Run the combination of a set of 1D estimates.
+   * Run the combination of a set of estimates.
    *
    * @param flag The integer flag identifying the combination to be run.
    * @param combo_category The human-readable title of the category of combinations run by the executable, to be
    * printed in the banner.
    * @param combinations The map of all available combinations.
    * @param estimates The vector of all estimates that the combinations are based on.
-   * @param names_obs The vector containing the name of the observable.
+   * @param names_obs The vector of names of the observables, indexed by `Estimate::obs`.
    * @param names_unc The vector of names of the uncertainties, in the order they appear in the `vals` vector of each
    * estimate.
    * @param rho The vector of correlation coefficients for the uncertainties, in the order they appear in `names_unc`.
@@ -67,4 +109,35 @@ namespace BLUE {
                        const std::vector<TString>& names_unc, const std::vector<double>& rho,
                        const OutputFormat& format);
 
+  /**
+   * Run several combinations of a set of estimates in one go, with the same arguments as above.
+   *
+   * The estimates are filled once, and each combination only switches the set of active estimates. If `output` is not
+   * empty, the results are also written to a JSON file with the category, the names of the uncertainties, and one
+   * entry per combination with its flag, title, estimates and averaged observables, and, per observable, the value,
+   * total uncertainty and uncertainties per source (in the order of `names_unc`). It also contains the weights (one
+   * row per estimate, one column per observable), the correlation matrix of the observables, the derivatives of the
+   * value and total uncertainty of each observable with respect to the correlation of each source (`value_drho` and
+   * `uncertainty_drho`, see Blue::GetJacVal), chi2, ndof and probability. The same derivatives, with those with
+   * respect to the uncertainties, are printed only if `print_jacobian` is set, since they take more than a hundred
+   * lines per observable.
+   */
+  void run_combination(const std::vector<int>& flags, const std::string& combo_category,
+                       const Combinations& combinations, const Estimates& estimates,
+                       const std::vector<TString>& names_obs, const std::vector<TString>& names_unc,
+                       const std::vector<double>& rho, const OutputFormat& format,
+                       const std::filesystem::path& output = {}, bool print_jacobian = false);
+
+  /// Run the combinations selected by the command-line options.
+  void run_combination(const Options& options, const std::string& combo_category, const Combinations& combinations,
+                       const Estimates& estimates, const std::vector<TString>& names_obs,
+                       const std::vector<TString>& names_unc, const std::vector<double>& rho,
+                       const OutputFormat& format);
+
+  /**
+   * Solve the combination `flag` without printing anything, and return the averaged observables with their
+   * covariance. Used to feed BLUE averages to GammaCombo in-process (see PDF_BLUE).
+   */
+  Average average(const Inputs& inputs, int flag);
+
 }  // namespace BLUE
@@ -0,0 +1,156 @@
+/**
+ * Charm Combination
+ * Author: tommaso.pajero@cern.ch
+ * Date: October 2026
+ *
+ * Micro-benchmark of the BLUE solver. It times the iterative drivers SolveRelUnc (with Anderson depth 0 and 3),
+ * SolveScaRho, SolveScaSta and SolvePosWei, and a single FixInp + Solve cycle, on a synthetic combination, and counts
+ * the heap allocations per call.
+ *
+ * Run it with
+ *
+ *    ./bin/BLUE/bench-solve [n-estimates] [n-uncertainties] [n-repetitions]
+ *
+ */
+
+#include <BLUE/Blue.h>
+
+#include <TMatrixD.h>
+#include <TROOT.h>
+#include <TString.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+  /// Number of calls to the global operator new (and hence new[]) since the start of the program, from all threads.
+  std::atomic<std::size_t> n_allocations = 0;
+}  // namespace
+
+void* operator new(const std::size_t size) {
+  n_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (auto ptr = std::malloc(size > 0 ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+  /**
+   * Create a combination of `num_est` estimates of one observable, with a statistical and `num_unc - 1` systematic
+   * uncertainties, each with a statistical precision of 10%. The statistical uncertainties are uncorrelated, and the
+   * systematic uncertainties of source k are correlated with rho = k / num_unc between all estimates.
+   */
+  std::unique_ptr<Blue> make_blue(const int num_est, const int num_unc) {
+    std::mt19937 rng(1);
+    std::normal_distribution<double> val(0., 0.1);
+    std::uniform_real_distribution<double> unc(0.05, 0.2);
+
+    std::vector<double> x_est;
+    std::vector<double> s_unc;
+    for (int i = 0; i < num_est; ++i) {
+      x_est.push_back(1. + val(rng));
+      for (int k = 0; k < num_unc; ++k) {
+        x_est.push_back(unc(rng));
+        s_unc.push_back(0.1 * x_est.back());
+      }
+    }
+    const TMatrixD inp_est(num_est, num_unc + 1, &x_est[0]);
+    const TMatrixD inp_sta(num_est, num_unc, &s_unc[0]);
+
+    auto blue = std::make_unique<Blue>(num_est, num_unc);
+    blue->SetQuiet();
+    blue->FillEst(&inp_est);
+    blue->FillSta(&inp_sta);
+    for (int k = 0; k < num_unc; ++k) blue->FillCor(k, static_cast<double>(k) / num_unc);
+    blue->FixInp();
+    return blue;
+  }
+
+  /// Call `run` `calls` times after a warm-up call, and print the wall time and heap allocations per call.
+  template <typename F>
+  void measure(const std::string& name, const int calls, F&& run) {
+    run();
+    const auto start_allocations = n_allocations;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i) run();
+    const std::chrono::duration<double, std::micro> time = std::chrono::steady_clock::now() - start;
+    std::cout << std::format("{:<22} {:>8} calls {:>14.1f} us/call {:>14.1f} allocations/call\n", name, calls,
+                             time.count() / calls, static_cast<double>(n_allocations - start_allocations) / calls);
+  }
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc > 4 || (argc > 1 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help"))) {
+    std::cerr << std::format("Usage: {} [n-estimates] [n-uncertainties] [n-repetitions]\n", argv[0]);
+    return argc > 4 ? EXIT_FAILURE : EXIT_SUCCESS;
+  }
+  const int num_est = argc > 1 ? std::atoi(argv[1]) : 20;
+  const int num_unc = argc > 2 ? std::atoi(argv[2]) : 4;
+  const int num_rep = argc > 3 ? std::atoi(argv[3]) : 1000;
+  std::cout << std::format("{} estimates, {} uncertainties\n", num_est, num_unc);
+  // SolveScaRho and SolveScaSta spread their work over all cores
+  ROOT::EnableThreadSafety();
+
+  // A single FixInp + Solve, which is what the iterative drivers repeat
+  auto blue = make_blue(num_est, num_unc);
+  measure("FixInp + Solve", num_rep, [&blue] {
+    blue->ReleaseInp();
+    blue->FixInp();
+    blue->Solve();
+  });
+
+  // SolveRelUnc, with all uncertainties relative, with and without acceleration
+  for (const int depth : {0, 3}) {
+    blue = make_blue(num_est, num_unc);
+    blue->SetRelUnc();
+    blue->SetAccRelUnc(depth);
+    measure(std::format("SolveRelUnc(0.001%) {}", depth), num_rep / 10, [&blue] {
+      blue->ReleaseInp();
+      blue->FixInp();
+      blue->SolveRelUnc(0.001);
+    });
+    std::cout << std::format("{:<22} {:>8} iterations\n", "", blue->GetNumRelUnc());
+  }
+
+  // SolveScaRho, which scans the correlation of each source between 0 and 1 (SolveScaRho leaves the quiet mode)
+  for (const int flag : {0, 1}) {
+    blue = make_blue(num_est, num_unc);
+    measure(std::format("SolveScaRho({})", flag), num_rep / 100 > 0 ? num_rep / 100 : 1, [&blue, flag] {
+      blue->ReleaseInp();
+      blue->FixInp();
+      blue->SolveScaRho(flag);
+      blue->SetQuiet();
+    });
+  }
+
+  // SolveScaSta, which solves the combination once per simulated input
+  blue = make_blue(num_est, num_unc);
+  measure("SolveScaSta(0)", num_rep / 100 > 0 ? num_rep / 100 : 1, [&blue] {
+    blue->ReleaseInp();
+    blue->FixInp();
+    blue->SolveScaSta(0);
+  });
+
+  // SolvePosWei, which de-activates the estimates with negative weights (all are re-activated before each call)
+  blue = make_blue(num_est, num_unc);
+  measure("SolvePosWei", num_rep / 10 > 0 ? num_rep / 10 : 1, [&blue, num_est] {
+    blue->ReleaseInp();
+    for (int i = 0; i < num_est; ++i) blue->SetActiveEst(i);
+    blue->FixInp();
+    blue->SolvePosWei();
+  });
+
+  return EXIT_SUCCESS;
+}
@@ -43,9 +43,9 @@ const BLUE::Combinations combinations = {
  * Perform the combination of a set of ACP(D0 -> KS KS) measurements.
  */
 int main(int argc, char** argv) {
-  const int flag = BLUE::parse_args(argc, argv, combinations);
+  const auto options = BLUE::parse_args(argc, argv, combinations);
 
-  BLUE::run_combination(flag, "ACP(D0 -> KS KS)", combinations, estimates, names_obs, names_unc, rho,
+  BLUE::run_combination(options, "ACP(D0 -> KS KS)", combinations, estimates, names_obs, names_unc, rho,
                         BLUE::OutputFormat{"%+1.4f", "%2.4f", "%2.4f", "%2.4f", "%2.4f", "%2.4f", ""});
   return EXIT_SUCCESS;
 }
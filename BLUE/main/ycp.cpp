@@ -81,9 +81,9 @@ const BLUE::Combinations combinations = {
  * Perform the combination of a set of yCP (CP-even) measurements.
  */
 int main(int argc, char** argv) {
-  const int flag = BLUE::parse_args(argc, argv, combinations);
+  const auto options = BLUE::parse_args(argc, argv, combinations);
 
-  BLUE::run_combination(flag, "yCP (CP-even)", combinations, estimates, names_obs, names_unc, rho,
+  BLUE::run_combination(options, "yCP (CP-even)", combinations, estimates, names_obs, names_unc, rho,
                         BLUE::OutputFormat{});
   return EXIT_SUCCESS;
 }
@@ -26,9 +26,21 @@
 #include "TH2F.h"
 #include "TArrow.h"
 #include "TMatrixDEigen.h"
+#include "TMatrixDSymEigen.h"
 #include "TRandom3.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <BLUE/Blue.h>
 
+// The graphics use named ROOT objects, found and deleted via gROOT, and the
+// global gStyle and gPad. They are serialised between all Blue objects, such
+// that Blue objects in different threads can solve concurrently, since the
+// solvers do not touch any global ROOT state
+static std::mutex RooMtx;
+
 // ----> First the implementation of the public member functions
 
 //------------------------------------------------------------------------------
@@ -163,6 +175,7 @@ Blue::~Blue(){
 
   // Array of coefficients forBLUE with relative uncertainties
   Cof->Delete(); Cof = NULL;
+  ResRelUnc->Delete(); ResRelUnc = NULL;
 
   // The list of importance and the steering flag for SolveAccImp
   delete LisImp; LisImp = NULL;
@@ -172,6 +185,8 @@ Blue::~Blue(){
   delete UncImp; UncImp = NULL;
   delete StaImp; StaImp = NULL;
   delete SysImp; SysImp = NULL;
+  delete ValLea; ValLea = NULL;
+  delete UncLea; UncLea = NULL;
 
   // The arrays for PlotRes
   delete Indx; Indx = NULL;
@@ -196,17 +211,13 @@ Blue::~Blue(){
   XvaOrig->Delete(); XvaOrig = NULL;
   SigOrig->Delete(); SigOrig = NULL;
   UncOrig->Delete(); UncOrig = NULL;
-  CorOrig->Delete(); CorOrig = NULL;
+  for(Int_t k = 0; k<InpUncOrig; k++){CorOrig[k]->Delete(); CorOrig[k] = NULL;}
+  delete [] CorOrig; CorOrig = NULL;
   UmaOrig->Delete(); UmaOrig = NULL;
   UtrOrig->Delete(); UtrOrig = NULL;
   StaOrig->Delete(); StaOrig = NULL;
   SgnOrig->Delete(); SgnOrig = NULL;
 
-  // Structures to allow for a simulation
-  XvaSimu->Delete(); XvaSimu = NULL;
-  UncSimu->Delete(); UncSimu = NULL;
-  CorSimu->Delete(); CorSimu = NULL;
- 
   // Structure for SolveScaSta
   ValResSimu->Delete(); ValResSimu = NULL;
   UncResSimu->Delete(); UncResSimu = NULL;
@@ -218,7 +229,8 @@ Blue::~Blue(){
 
   // Matrices to do the job
   Unc->Delete(); Unc = NULL;
-  Cor->Delete(); Cor = NULL;
+  for(Int_t k = 0; k<InpUncOrig; k++){Cor[k]->Delete(); Cor[k] = NULL;}
+  delete [] Cor; Cor = NULL;
   Cov->Delete(); Cov = NULL;
   CovI->Delete(); CovI = NULL;
   Rho->Delete(); Rho = NULL;
@@ -232,6 +244,24 @@ Blue::~Blue(){
   CorRes->Delete(); CorRes = NULL;
   CovRes->Delete(); CovRes = NULL;
   RhoRes->Delete(); RhoRes = NULL;
+  JacValRes->Delete(); JacValRes = NULL;
+  JacCovRes->Delete(); JacCovRes = NULL;
+
+  // Workspace
+  WrkCor->Delete(); WrkCor = NULL;
+  WrkH->Delete(); WrkH = NULL;
+  WrkI->Delete(); WrkI = NULL;
+  WrkJ->Delete(); WrkJ = NULL;
+  WrkK->Delete(); WrkK = NULL;
+  WrkL->Delete(); WrkL = NULL;
+  WrkM->Delete(); WrkM = NULL;
+  WrkN->Delete(); WrkN = NULL;
+  WrkO->Delete(); WrkO = NULL;
+  WrkP->Delete(); WrkP = NULL;
+  for(Int_t l = 0; l<2; l++){
+    WrkSym[l]->Delete(); WrkSym[l] = NULL;
+    delete WrkChl[l]; WrkChl[l] = NULL;
+  }
 
   // Vectors for the information weights
   VarInd->Delete(); VarInd = NULL;
@@ -355,15 +385,19 @@ void Blue::FixInp(){
     }
   }
 
+  // Adjust the workspace to the active estimates and observables
+  ResizeWork();
+
   // Fill U and UT matricees
-  TMatrixD *F  = new TMatrixD(InpEst,InpObs);
+  Uma->ResizeTo(InpEst,InpObs);
+  Utr->ResizeTo(InpObs,InpEst);
   Int_t j = 0;
   Int_t m = 0;
   for(Int_t i = 0; i<InpEstOrig; i++){
     if(IsActiveEst(i) == 1){
       for(Int_t n = 0; n<InpObsOrig; n++){
 	if(IsActiveObs(n) == 1){
-	  F->operator()(j,m) = UmaOrig->operator()(i,n);
+	  Uma->operator()(j,m) = UmaOrig->operator()(i,n);
 	  m = m + 1;
 	}
       }
@@ -371,16 +405,12 @@ void Blue::FixInp(){
       m = 0;
     }
   }
-  Uma->Delete(); Uma = new TMatrixD(InpEst,InpObs);
-  Utr->Delete(); Utr = new TMatrixD(InpObs,InpEst);
-  Uma->operator=(*F);
   Utr->Transpose(*Uma);
   //printf("... Blue->FixInp(): Uma \n"); Uma->Print();
   //printf("... Blue->FixInp(): Utr \n"); Utr->Print();
-  F->Delete(); F = NULL;
 
   // Fill vector of estimates
-  Xva->Delete(); Xva = new TVectorD(InpEst);
+  Xva->ResizeTo(InpEst);
   j = 0;
   for(Int_t i = 0; i<InpEstOrig; i++){
     if(IsActiveEst(i) == 1){
@@ -388,13 +418,11 @@ void Blue::FixInp(){
       j = j + 1;
     }
   }
-  // Reset to simulation values if needed
-  if(IsSimulation() == 1)Xva->SetSub(0,*XvaSimu);
   //printf("... Blue->FixInp(): Xva \n"); Xva->Print();
 
   // Fill matrix of stat precision and sign of systematic uncertainties
-  Sta->Delete(); Sta = new TMatrixD(InpEst,InpUnc);
-  Sgn->Delete(); Sgn = new TMatrixD(InpEst,InpUnc);
+  Sta->ResizeTo(InpEst,InpUnc);
+  Sgn->ResizeTo(InpEst,InpUnc);
   Int_t is = 0, ks = 0;
   for(Int_t i = 0; i<InpEstOrig; i++){
     ks = 0;
@@ -413,8 +441,7 @@ void Blue::FixInp(){
   //printf("... Blue->FixInp(): Sgn \n"); PrintMatrix(Sgn,"%5.2f");
 
   // Fill matrix of uncertainties
-  Unc->Delete(); Unc  = new TMatrixD(InpEst*InpUnc,InpEst*InpUnc);
-  Int_t IRow, IRowOrig;
+  Unc->ResizeTo(InpEst,InpUnc);
   j = 0;
   Int_t l = 0;
   Double_t ValCom = 0, UncCom = 0;
@@ -423,9 +450,7 @@ void Blue::FixInp(){
       j = 0;
       for(Int_t i = 0; i<InpEstOrig; i++){
 	if(IsActiveEst(i) == 1){
-	  IRowOrig=i+k*InpEstOrig;
-	  IRow=j+l*InpEst;
-	  UncCom = UncOrig->operator()(IRowOrig,IRowOrig);
+	  UncCom = UncOrig->operator()(i,k);
 	  // Rescale relative uncertainties
 	  if(IsRelValUnc() == 1 && IsRelValUnc(k) == 1){
 	    ValCom = 0.;
@@ -436,16 +461,13 @@ void Blue::FixInp(){
 	    UncCom = CalcRelUnc(i, k, ValCom);
 	    if(UncCom < 0)IFail = IFail + 1;
 	  }
-	  Unc->operator()(IRow,IRow) = UncCom;
+	  Unc->operator()(j,l) = UncCom;
 	  j = j + 1;
 	}
       }
       l = l + 1;
     }
   }
-
-  // Reset to simulation values if needed
-  if(IsSimulation() == 1)Unc->SetSub(0,0,*UncSimu);
   //printf("... Blue->FixInp(): Unc \n"); Unc->Print();
   if(IFail >= 1){
     printf("... Blue->FixInp(): --------------------------------");
@@ -461,22 +483,14 @@ void Blue::FixInp(){
   
   // Fill matrix of correlations
   //printf("... Blue->FixInp(): CorOrig \n"); CorOrig->Print();
-  TMatrixD *FN  = new TMatrixD(InpEst,InpEst);
-  TMatrixD *FO  = new TMatrixD(InpEstOrig,InpEstOrig);
-  TMatrixD *FS  = new TMatrixD(InpEstOrig,InpEstOrig);
-  TMatrixD *CC  = new TMatrixD(InpEst*InpUnc,InpEst*InpUnc);
+  TMatrixD *FO  = WrkCor;
   
   Int_t ii = 0;
   Int_t jj = 0;
   Int_t kk = 0;
-  Int_t IRowLow, IRowHig, IColLow, IColHig;
   for(Int_t k = 0; k<InpUncOrig; k++){ 
     if(IsActiveUnc(k) == 1){
-      IRowLow = k*InpEstOrig; 
-      IRowHig = IRowLow + InpEstOrig-1;
-      IColLow = IRowLow;
-      IColHig = IRowHig;
-      CorOrig->GetSub(IRowLow, IRowHig, IColLow, IColHig, *FO, "S");
+      FO->operator=(*CorOrig[k]);
       //printf("... Blue->FixInp(): F0 \n"); FO->Print();
 
       // This is the place to do 1) changed, 2) scaled or 3) reduced
@@ -506,19 +520,20 @@ void Blue::FixInp(){
       // 3) Do the reduced correlations
       //UncOrig->Print();
       if(IsRhoRedUnc(k) == 1){
-	UncOrig->GetSub(IRowLow, IRowHig, IColLow, IColHig, *FS, "S");
-	//printf("... Blue->FixInp(): FS \n"); FS->Print();
 	//printf("... Blue->FixInp(): FO \n"); FO->Print();
 	Double_t RedCor, Limit = 0.00001, FullCor = 0.99;
+	Double_t UncIi, UncJj;
 	for(Int_t i1 = 0; i1<InpEstOrig; i1++){
 	  for(Int_t j1 = i1+1; j1<InpEstOrig; j1++){
-	    if(FS->operator()(i1,i1) < FS->operator()(j1,j1)){
-	      RedCor = FS->operator()(i1,i1) / FS->operator()(j1,j1);
+	    UncIi = UncOrig->operator()(i1,k);
+	    UncJj = UncOrig->operator()(j1,k);
+	    if(UncIi < UncJj){
+	      RedCor = UncIi / UncJj;
 	    }else{
-	      if(FS->operator()(i1,i1) > Limit){
-		RedCor = FS->operator()(j1,j1) / FS->operator()(i1,i1);
+	      if(UncIi > Limit){
+		RedCor = UncJj / UncIi;
 	      }else{
-		RedCor = FS->operator()(j1,j1) / Limit;
+		RedCor = UncJj / Limit;
 	      }
 	    }
 	    //printf("... Blue->FixInp(): RC %2i %2i %5.3f \n",i1,j1,RedCor); 
@@ -544,13 +559,14 @@ void Blue::FixInp(){
       }
 
       // Fill result
+      Cor[kk]->ResizeTo(InpEst,InpEst);
       for(Int_t iii = 0; iii<InpEstOrig; iii++){
 	if(IsActiveEst(iii) == 1){	  
 	  for(Int_t jjj = 0; jjj<InpEstOrig; jjj++){
 	    if(IsActiveEst(jjj) == 1){
 	      //printf("... Blue->FixInp() fill);
 	      //printf(" i=%2i, j=%2i, ii=%2i, jj=%2i \n",iii,jjj,ii,jj);
-	      FN->operator()(ii,jj) = FO->operator()(iii,jjj);
+	      Cor[kk]->operator()(ii,jj) = FO->operator()(iii,jjj);
 	      jj = jj + 1;
 	    }
 	  }
@@ -558,24 +574,14 @@ void Blue::FixInp(){
 	  jj = 0;
 	}
       }
-      IRowLow = kk*InpEst; 
-      IColLow = IRowLow;
-      CC->SetSub(IRowLow, IColLow, *FN);
       ii = 0;
       jj = 0;
       kk = kk + 1;
     }
   }
-  Cor->Delete(); Cor = new TMatrixD(InpEst*InpUnc,InpEst*InpUnc);
-  Cor->operator=(*CC);
-  FN->Delete(); FN = NULL;
-  FO->Delete(); FO = NULL;
-  FS->Delete(); FS = NULL;
-  CC->Delete(); CC = NULL;
+  FO = NULL;
 
-  // Reset to simulation values if needed
-  if(IsSimulation() == 1)Cor->SetSub(0,0,*CorSimu);
-  //printf("... Blue->FixInp(): Cor \n"); Cor->Print();
+  //printf("... Blue->FixInp(): Cor[0] \n"); Cor[0]->Print();
 
   // Calculate covariance
   FillCov();
@@ -634,10 +640,8 @@ void Blue::FixInp(){
   CalcParams();
 
   // Refresh the Likelihood matrix
-  LikRes->Delete(); LikRes = new TMatrixD(InpObs,LikDim);
-
-  //Setup ROOT style
-  SetupRoot();
+  LikRes->ResizeTo(InpObs,LikDim);
+  LikRes->Zero();
 
   // Set the flag 
   SetFixedInp(1);
@@ -708,49 +712,39 @@ void Blue::Solve(){
     PrintStatus();
   }
 
-  // Reset weight matrix and pull vector
-  Lam->Delete(); Lam  = new TMatrixD(InpEst,InpObs);
-  Pul->Delete(); Pul  = new TVectorD(InpEst);
+  // Reset weight matrix and pull vector, the sizes only change with FixInp
+  ResizeWork();
+  Lam->ResizeTo(InpEst,InpObs);
+  Pul->ResizeTo(InpEst);
 
   // Reset matrices for the results
-  XvaRes->Delete(); XvaRes = new TVectorD(InpObs);
-  CorRes->Delete(); CorRes = new TMatrixD(InpObs*InpUnc,InpObs*InpUnc);
-  CovRes->Delete(); CovRes = new TMatrixD(InpObs,InpObs);
-  RhoRes->Delete(); RhoRes = new TMatrixD(InpObs,InpObs);
+  XvaRes->ResizeTo(InpObs);
+  CorRes->ResizeTo(InpObs*InpUnc,InpObs*InpUnc);
+  CorRes->Zero();
+  CovRes->ResizeTo(InpObs,InpObs);
+  RhoRes->ResizeTo(InpObs,InpObs);
 
   // Get weight matrix
   //-1)      H: (Cov-1 * U)
   //-2) CovRes: (UT * Cov-1 * U)-1
   //-3)    Lam: (Cov-1 * U) * (UT * Cov-1 * U)-11 
-  TMatrixD *H = new TMatrixD(InpEst,InpObs);
+  TMatrixD *H = WrkH;
   H->Mult(*CovI, *Uma);
   CovRes->Mult(*Utr,*H);
-  CovRes->Invert();
+  CalcInvert(CovRes, CovRes, "Solve()");
   Lam->Mult(*H, *CovRes);
-  H->Delete(); H = NULL;
   //printf("... Blue->Solve(): Weight matrix\n"); Lam->Print();
 
   // Calculate covariance matrix of observables per uncertainty source
-  TMatrixD *C = new TMatrixD(InpEst,InpEst);
-  TMatrixD *E = new TMatrixD(InpEst,InpEst);
-  TMatrixD *F = new TMatrixD(InpEst,InpEst);
-  TMatrixD *I = new TMatrixD(InpEst,InpEst);
+  TMatrixD *I = WrkI;
   
-  TMatrixD *J = new TMatrixD(InpEst,InpObs);
-  TMatrixD *K = new TMatrixD(InpObs,InpEst);
-  TMatrixD *L = new TMatrixD(InpObs,InpObs);
+  TMatrixD *J = WrkJ;
+  TMatrixD *K = WrkK;
+  TMatrixD *L = WrkL;
   
-  Int_t IRowLow, IRowHig, IColLow, IColHig;
   for(Int_t k = 0; k<InpUnc; k++){
     // Get covariance matrix per uncertainty source
-    IRowLow = k*InpEst; 
-    IRowHig = IRowLow + InpEst-1;
-    IColLow = IRowLow;
-    IColHig = IRowHig;
-    Unc->GetSub(IRowLow, IRowHig, IColLow, IColHig, *E, "S");
-    Cor->GetSub(IRowLow, IRowHig, IColLow, IColHig, *C, "S");
-    F->Mult(*E, *C);
-    I->Mult(*F, *E);
+    FillCovSource(k, I);
     //printf("... Blue->Solve(): Cov_i \n"); I->Print();
     // Get covariance Eq 18. Cov(n,m)_k = Lam(n,i)*Cov(i,j)_k*Lam(j,m)
     J->Mult(*I, *Lam);
@@ -762,13 +756,6 @@ void Blue::Solve(){
     CorRes->SetSub(k*InpObs,k*InpObs,*L);
     //CorRes->Print();
   }
-  C->Delete(); C = NULL;
-  E->Delete(); E = NULL;
-  F->Delete(); F = NULL;
-  I->Delete(); I = NULL;
-  J->Delete(); J = NULL;
-  K->Delete(); K = NULL;
-  L->Delete(); L = NULL;
 
   // Calculate correlation matrix of results
   RhoRes->SetSub(0,0,*CovRes);
@@ -786,7 +773,7 @@ void Blue::Solve(){
   }
   
   // Calculate combined values XvaRes(n) = Sum_i Lam(i,n) * Xva(i)
-  Double_t val;
+  Double_t val = 0.;
   for (Int_t n = 0; n < InpObs; n++){    
     for(Int_t i = 0; i<InpEst; i++){  
       val = val + Lam->operator()(i,n)*Xva->operator()(i);
@@ -802,10 +789,10 @@ void Blue::Solve(){
   //-2) O: N^T
   //-3) M: (CovI * N)
   //-3) P: chiq: (O * M)
-  TMatrixD *M = new TMatrixD(InpEst,1);
-  TMatrixD *N = new TMatrixD(InpEst,1);
-  TMatrixD *O = new TMatrixD(1,InpEst);
-  TMatrixD *P = new TMatrixD(1,1);
+  TMatrixD *M = WrkM;
+  TMatrixD *N = WrkN;
+  TMatrixD *O = WrkO;
+  TMatrixD *P = WrkP;
 
   // Fill N, calculate O, use val from above
   // Calculate Pull on the fly
@@ -832,9 +819,6 @@ void Blue::Solve(){
   ChiQua = P->operator()(0,0);
   NumDof = InpEst - InpObs;
   ChiPro = TMath::Prob(ChiQua,NumDof);
-
-  // Clean up
-  M->Delete(); N->Delete(); O->Delete(); P->Delete();
   
   // Success
   SetIsSolved(1);
@@ -899,50 +883,145 @@ void Blue::SolveRelUnc(const Double_t Dx){
   // Set relative uncertainty flag
   SetRelValUnc(1);
 
-  // Loop until convergence, or at most ILm times
-  Int_t    Iok = 0, ILo = 0, ILm = 200;
-  Double_t Old = 0, New = 0, Del = 0;
-  TVectorD* XvaResLast = new TVectorD(GetActObs());
+  // Iterate x -> G(x) until convergence, or at most MaxRelUnc times. G(x)
+  // is the result of Solve() with the relative uncertainties rescaled to x,
+  // which only needs the covariance to be refreshed, see FillRelUnc().
+  // With AndRelUnc > 0 the iteration is accelerated a la Anderson: with the
+  // residual f = G(x) - x and the differences DF and DG of the residuals
+  // and results of the last AndRelUnc iterations, the next point is
+  // G(x) - DG*gam, where gam minimises |f - DF*gam|
+  Int_t    Iok = 0, ILo = 0, IGiv = 0, IFail = 0;
+  Int_t    NumHis = 0, IndHis = 0, NumCol = AndRelUnc > 0 ? AndRelUnc : 1;
+  Double_t Old = 0, New = 0, Del = 0, DelMax = 0;
+  TVectorD* XvaIte = new TVectorD(InpObs);
+  TVectorD* XvaMap = new TVectorD(InpObs);
+  TVectorD* ResIte = new TVectorD(InpObs);
+  TVectorD* ResLas = new TVectorD(InpObs);
+  TMatrixD* DifRes = new TMatrixD(InpObs,NumCol);
+  TMatrixD* DifMap = new TMatrixD(InpObs,NumCol);
+  XvaIte->operator=(*XvaRes);
+  XvaMap->operator=(*XvaRes);
+  ResRelUnc->Zero();
+  NumRelUnc = 0;
   while(Iok == 0){
     Iok = 1;
     ILo = ILo + 1;
-    // Save result from last iteration
-    for(Int_t n = 0; n<GetActObs(); n++){
-      XvaResLast->operator()(n) = XvaRes->operator()(n);
+
+    // Rescale the uncertainties to the present point, if this is unphysical
+    // for an accelerated point take the plain step instead
+    XvaRes->operator=(*XvaIte);
+    IFail = FillRelUnc();
+    if(IFail > 0 && NumHis > 0){
+      XvaIte->operator=(*XvaMap);
+      XvaRes->operator=(*XvaMap);
+      NumHis = 0;
+      IndHis = 0;
+      IFail = FillRelUnc();
+    }
+    if(IFail > 0){
+      printf("... Blue->SolveRelUnc(%5.3f%%): Unphysical uncertainties", Dx);
+      printf(" in iteration %3i.", ILo);
+      printf(" I give up and take the result from the last iteration. \n");
+      XvaRes->operator=(*XvaMap);
+      IGiv = 1;
+      break;
     }
+
     // Solve next time
-    ReleaseInp();
-    FixInp();
+    SetIsSolved(0);
     Solve();
     if(IsPrintLevel() >= 1){
       printf("... Blue->SolveRelUnc(%5.3f%%): Next Iteration = %2i\n", Dx, ILo);
     }
-    // Loop over observables and estimates check difference
-    for(Int_t n = 0; n<GetActObs(); n++){
-      Old = XvaResLast->operator()(n);
+
+    // Loop over observables check difference
+    DelMax = 0;
+    for(Int_t n = 0; n<InpObs; n++){
+      Old = XvaIte->operator()(n);
       New = XvaRes->operator()(n);
       Del = 100.*TMath::Abs(1.-New/Old);
       if(Del > Dx)Iok = 0;
+      if(Del > DelMax)DelMax = Del;
       if(IsPrintLevel() >= 1){
 	printf("... Blue->SolveRelUnc(%5.3f%%):", Dx);
 	printf(" Old, New, Dif = %7.5f %7.5f %7.5f %% \n", Old, New, Del);
       }
     }
-    if(ILo == ILm && Iok == 0){
+    ResRelUnc->operator()(ILo-1) = DelMax;
+    NumRelUnc = ILo;
+
+    // Update the history of residuals and results
+    for(Int_t n = 0; n<InpObs; n++){
+      ResIte->operator()(n) = XvaRes->operator()(n) - XvaIte->operator()(n);
+    }
+    if(AndRelUnc > 0 && ILo > 1){
+      for(Int_t n = 0; n<InpObs; n++){
+	DifRes->operator()(n,IndHis) = 
+	  ResIte->operator()(n) - ResLas->operator()(n);
+	DifMap->operator()(n,IndHis) = 
+	  XvaRes->operator()(n) - XvaMap->operator()(n);
+      }
+      IndHis = (IndHis + 1) % AndRelUnc;
+      if(NumHis < AndRelUnc)NumHis = NumHis + 1;
+    }
+    ResLas->operator=(*ResIte);
+    XvaMap->operator=(*XvaRes);
+
+    // The next point, plain or accelerated
+    XvaIte->operator=(*XvaRes);
+    if(Iok == 0 && NumHis > 0){
+      TMatrixD Nor(NumHis,NumHis);
+      TVectorD Rhs(NumHis);
+      Double_t DiaPro = 1., Det = 0.;
+      for(Int_t p = 0; p<NumHis; p++){
+	for(Int_t q = 0; q<NumHis; q++){
+	  for(Int_t n = 0; n<InpObs; n++){
+	    Nor(p,q) += DifRes->operator()(n,p)*DifRes->operator()(n,q);
+	  }
+	}
+	for(Int_t n = 0; n<InpObs; n++){
+	  Rhs(p) += DifRes->operator()(n,p)*ResIte->operator()(n);
+	}
+	DiaPro = DiaPro * Nor(p,p);
+      }
+      Nor.Invert(&Det);
+      // Skip degenerate histories, e.g. more iterations than observables
+      if(DiaPro > 0 && TMath::Abs(Det) > 1.E-12*DiaPro){
+	Rhs *= Nor;
+	for(Int_t n = 0; n<InpObs; n++){
+	  for(Int_t p = 0; p<NumHis; p++){
+	    XvaIte->operator()(n) -= DifMap->operator()(n,p)*Rhs(p);
+	  }
+	}
+      }else{
+	NumHis = 0;
+	IndHis = 0;
+      }
+    }
+
+    if(ILo == MaxRelUnc && Iok == 0){
       printf("... Blue->SolveRelUnc(%5.3f%%): No convergence", Dx);
       printf(" after %3i iterations.", ILo);
       printf(" I give up and take the result from the last iteration. \n");
       Iok = 1;
-      ILo = 0;
+      IGiv = 1;
     }
   }
-  if(ILo != 0 && IsQuiet() == 0){
+  if(IGiv == 0 && IsQuiet() == 0){
     printf("... Blue->SolveRelUnc(%5.3f%%): Success after\n", Dx);
     printf(" %2i iterations \n", ILo);
   }
 
   // Clean up
-  XvaResLast->Delete(); XvaResLast = NULL; 
+  XvaIte->Delete(); XvaIte = NULL; 
+  XvaMap->Delete(); XvaMap = NULL; 
+  ResIte->Delete(); ResIte = NULL; 
+  ResLas->Delete(); ResLas = NULL; 
+  DifRes->Delete(); DifRes = NULL; 
+  DifMap->Delete(); DifMap = NULL; 
+
+  // The parameters belong to the final uncertainties
+  CalcParams();
 
   // Clear relative uncertainty flag
   SetRelValUnc(0);
@@ -1070,6 +1149,17 @@ void Blue::SolveAccImp(const Int_t ImpFla, const Double_t Dx){
   //printf("... Blue->SolveAccImp(): Lam \n"); Lam->Print();
   //printf("... Blue->SolveAccImp(): Wei \n"); Wei->Print();
   
+  // Workspace for the rank-one updates, the covariance of the statistical
+  // uncertainty is needed for StaImp
+  TMatrixD* InvAcc = new TMatrixD(InpEst,InpEst);
+  TMatrixD* CovSta = new TMatrixD(InpEst,InpEst);
+  TMatrixD* HAcc   = new TMatrixD(InpEst,InpObs);
+  TMatrixD* CovAcc = new TMatrixD(InpObs,InpObs);
+  TMatrixD* LamAcc = new TMatrixD(InpEst,InpObs);
+  TMatrixD* VecAcc = new TMatrixD(InpEst,1);
+  std::vector<Int_t> ActAcc(InpEst);
+  FillCovSource(0, CovSta);
+
   // Loop over observables
   Double_t compare = 0;
   Int_t ifound = -1;
@@ -1123,7 +1213,7 @@ void Blue::SolveAccImp(const Int_t ImpFla, const Double_t Dx){
     //printf("... Blue->SolveAccImp(): IndImp \n"); IndImp->Print();
     ValImp->operator()(0,n) = Xva->operator()(ActPre);
     UncImp->operator()(0,n) = Sig->operator()(ActPre);
-    StaImp->operator()(0,n) = Unc->operator()(0*InpEst+ActPre,0*InpEst+ActPre);
+    StaImp->operator()(0,n) = Unc->operator()(ActPre,0);
 
     // 24.5.17 protect for just one uncertainty source
     if(InpUnc == 1){SysImp->operator()(0,n) = 0.;
@@ -1144,28 +1234,49 @@ void Blue::SolveAccImp(const Int_t ImpFla, const Double_t Dx){
       printf("\n");
     }
   
-    // Disable all but the most precise estimate 
-    ReleaseInp();
-    for(Int_t i = 1; i<NnrEst[n]; i++){SetInActiveEst(LisImp[i]);};
-    FixInp();
+    // Start from the inverse covariance of all estimates and remove all but
+    // the most precise estimate of this observable, then add them back one
+    // at a time for decreasing importance. The inverse is updated by rank-one
+    // steps instead of repeating FixInp() and Solve(), see CalcInvDel() and
+    // CalcInvAdd(). The state of Blue is not changed
+    InvAcc->SetSub(0,0,*CovI);
+    for(Int_t i = 0; i<InpEst; i++){ActAcc[i] = 1;};
+    Int_t IPosi = 1;
+    for(Int_t i = 1; i<NnrEst[n]; i++){
+      if(IPosi == 1){IPosi = CalcInvDel(InvAcc, &ActAcc[0], 
+					IsIndexEst(LisImp[i]), VecAcc);
+      }else{ActAcc[IsIndexEst(LisImp[i])] = 0;
+      }
+    }
+    if(IPosi == 0)CalcInvAct(InvAcc, &ActAcc[0]);
       
     // Add one at a time for decreasing importance, store results
     Double_t d = 0;
     //29/11/17for(Int_t i = 1; i<NnrEst[n]; i++){
     for(Int_t i = 0; i<NnrEst[n]; i++){
-      ReleaseInp();      
-      if(i>0)SetActiveEst(LisImp[i]);
-      FixInp();
-      Solve();
+      if(i>0){
+	if(CalcInvAdd(InvAcc, &ActAcc[0], IsIndexEst(LisImp[i]), VecAcc) == 0){
+	  CalcInvAct(InvAcc, &ActAcc[0]);
+	}
+      }
+      CalcSolveInv(InvAcc, HAcc, CovAcc, LamAcc);
+      ValImp->operator()(i,n) = 0.;
+      d = 0.;
+      for(Int_t a = 0; a<InpEst; a++){
+	ValImp->operator()(i,n) += LamAcc->operator()(a,n)*Xva->operator()(a);
+	for(Int_t b = 0; b<InpEst; b++){
+	  d += LamAcc->operator()(a,n) * CovSta->operator()(a,b) *
+	    LamAcc->operator()(b,n);
+	}
+      }
+      UncImp->operator()(i,n) = TMath::Sqrt(CovAcc->operator()(n,n));
       if(IsPrintLevel() > 0){
 	printf("... Blue->SolveAccImp(): Add %2i,", LisImp[i]);
-	printf(" %s \n", GetNamEst(IsWhichEst(i)).Data());
-	PrintEst(ActPre);
-	PrintResult();
+	printf(" %s \n", GetNamEst(LisImp[i]).Data());
+	PrintEst(LisImp[i]);
+	printf("... Blue->SolveAccImp(): Observable %2i: %5.3f +- %5.3f \n",
+	       IsWhichObs(n), ValImp->operator()(i,n), UncImp->operator()(i,n));
       }
-      ValImp->operator()(i,n) = XvaRes->operator()(n);
-      UncImp->operator()(i,n) = TMath::Sqrt(CovRes->operator()(n,n));
-      d = CorRes->operator()(0*InpObs+n,0*InpObs+n);
       if(d >= 0){d = TMath::Sqrt(d);
       }else{d = -TMath::Sqrt(-d);
       }
@@ -1195,6 +1306,40 @@ void Blue::SolveAccImp(const Int_t ImpFla, const Double_t Dx){
   }
   Wei->Delete(); Wei = NULL;
 
+  // Leave-one-out: remove each estimate from the inverse covariance of all
+  // estimates and combine the rest. Not possible for the only estimate of an
+  // observable, flagged by an uncertainty of -1
+  ValLea->ResizeTo(InpEst,InpObs);
+  UncLea->ResizeTo(InpEst,InpObs);
+  for(Int_t i = 0; i<InpEst; i++){
+    if(NnrEst[IsIndexObs(EstWhichObs(IsWhichEst(i)))] == 1){
+      for(Int_t n = 0; n<InpObs; n++){
+	ValLea->operator()(i,n) =  0.;
+	UncLea->operator()(i,n) = -1.;
+      }
+      continue;
+    }
+    InvAcc->SetSub(0,0,*CovI);
+    for(Int_t j = 0; j<InpEst; j++){ActAcc[j] = 1;};
+    if(CalcInvDel(InvAcc, &ActAcc[0], i, VecAcc) == 0){
+      CalcInvAct(InvAcc, &ActAcc[0]);
+    }
+    CalcSolveInv(InvAcc, HAcc, CovAcc, LamAcc);
+    for(Int_t n = 0; n<InpObs; n++){
+      ValLea->operator()(i,n) = 0.;
+      for(Int_t a = 0; a<InpEst; a++){
+	ValLea->operator()(i,n) += LamAcc->operator()(a,n)*Xva->operator()(a);
+      }
+      UncLea->operator()(i,n) = TMath::Sqrt(CovAcc->operator()(n,n));
+    }
+  }
+  InvAcc->Delete(); InvAcc = NULL;
+  CovSta->Delete(); CovSta = NULL;
+  HAcc->Delete(); HAcc = NULL;
+  CovAcc->Delete(); CovAcc = NULL;
+  LamAcc->Delete(); LamAcc = NULL;
+  VecAcc->Delete(); VecAcc = NULL;
+
   // Find the last estimate to be combined
   Double_t DifVal = 0, DifUnc = 0;
   Int_t    NexImp = 0, NumImp = 0;
@@ -1220,7 +1365,10 @@ void Blue::SolveAccImp(const Int_t ImpFla, const Double_t Dx){
   SetIsSolvedAccImp(1);
 
   // Print out if wanted
-  if(IsPrintLevel() > 0)PrintAccImp();
+  if(IsPrintLevel() > 0){
+    PrintAccImp();
+    PrintAccImpLeaOut();
+  }
 
   // Return
   return;
@@ -1493,25 +1641,8 @@ void Blue::SolveScaSta(const Int_t IScSta){
   }
   StaFla = IScSta;
 
-  // Flag to initiate warning for StaFla == 1 and rho != 1
-  Int_t NotOne = 0;
-
-  // Reset the simulation structures to the actual size
-  XvaSimu->Delete(); XvaSimu = new TVectorD(InpEst);
-  UncSimu->Delete(); UncSimu = new TMatrixD(InpEst*InpUnc,InpEst*InpUnc);
-  CorSimu->Delete(); CorSimu = new TMatrixD(InpEst*InpUnc,InpEst*InpUnc);
-  TMatrixD* SgnSimu = new TMatrixD(InpEst,InpUnc);
-
-  // Solve once, save initial input and central result
+  // Solve once, save central result
   Solve();
-  //-input
-  TVectorD* XvaSave = new TVectorD(InpEst);
-  TMatrixD* UncSave = new TMatrixD(InpEst*InpUnc,InpEst*InpUnc);
-  TMatrixD* CorSave = new TMatrixD(InpEst*InpUnc,InpEst*InpUnc);
-  XvaSave->SetSub(0,*Xva);
-  UncSave->SetSub(0,0,*Unc);
-  CorSave->SetSub(0,0,*Cor);
-  //-result
   TVectorD* XvaResSave = new TVectorD(InpObs);
   TMatrixD* CovResSave = new TMatrixD(InpObs,InpObs);
   XvaResSave->SetSub(0,*XvaRes);
@@ -1527,91 +1658,158 @@ void Blue::SolveScaSta(const Int_t IScSta){
     StaResSimu->operator()(n,1) = TMath::Sqrt(CovResSave->operator()(n,n));
   }
 
-  // Initialise random number generator if needed
-  if(IsSimulation() == 0 && IsSeeded == 0)SimulInit(-1);
+  // The uncertainties the simulations fluctuate around. As FixInp() does
+  // before each Solve(), relative uncertainties are rescaled to the
+  // combined value. The estimates are not simulated, so this is the
+  // central value for all simulations, and it is done once here.
+  TMatrixD UncCen(*Unc);
+  if(IsRelValUnc() == 1){
+    Int_t IFail = 0;
+    Double_t ValCom = 0., UncCom = 0.;
+    for(Int_t k = 0; k<InpUnc; k++){
+      if(IsRelValUnc(LisUnc[k]) == 1){
+	for(Int_t i = 0; i<InpEst; i++){
+	  ValCom = 0.;
+	  for(Int_t n = 0; n<InpObs; n++){
+	    ValCom = ValCom + Uma->operator()(i,n)*XvaResSave->operator()(n);
+	  }
+	  UncCom = CalcRelUnc(LisEst[i], LisUnc[k], ValCom);
+	  if(UncCom < 0){
+	    IFail = IFail + 1;
+	  }else{
+	    UncCen(i,k) = UncCom;
+	  }
+	}
+      }
+    }
+    if(IFail >= 1){
+      printf("... Blue->SolveScaSta(%2i): WARNING %i relative", IScSta, IFail);
+      printf(" uncertainties kept at their values in FixInp() \n");
+    }
+  }
+
+  // Correlations will only be changed if rho_ijk == +-1, warn if others exist
+  Int_t NotOne = 0;
+  if(StaFla == 2){
+    Double_t d = 0., small = 0.001;
+    for(Int_t i = 0; i<InpEst; i++){
+      for(Int_t j = i+1; j<InpEst; j++){
+	for(Int_t k = 0; k<InpUnc; k++){ 
+	  if(Cor[k]->operator()(i,j) != 0.){
+	    d = TMath::Abs(TMath::Abs(Cor[k]->operator()(i,j)) - 1.);
+	    if(d > small && NotOne == 0){
+	      NotOne = 1;
+	      printf("... Blue->SolveScaSta(%2i): Reminder: I will",StaFla);
+	      printf(" only change correlations if rho_ijk == +-1 !! \n");
+	      printf("... Blue->SolveScaSta(%2i): So e.g. not for",StaFla);
+	      printf(" estimates i=(%i,%i)",IsWhichEst(i),IsWhichEst(j));
+	      printf(" and Uncertainty k=%i\n",IsWhichUnc(k));
+	    }
+	  }
+	}
+      }
+    }
+  }
 
-  // Set the Simulation flag
-  SetIsSimulation(1);
+  // Initialise the seed if needed
+  if(IsSeeded == 0)SimulInit(-1);
 
   // Set quiet modus
+  Int_t QuiSav = IsQuiet();
   SetQuiet(1);
 
-  // Do the Scan
-  Double_t x = 0., u = 0., e = 0.;
-  for(Int_t N = 0; N<NumSim; N++){
-
-    // Reset simulation values to the ones saved at start
-    XvaSimu->SetSub(0,*XvaSave);
-    UncSimu->SetSub(0,0,*UncSave);
-    CorSimu->SetSub(0,0,*CorSave);
-
-    // Generate changed uncertainties, save sign changes
-    Int_t m = 0;
-    SgnSimu->Zero();
-    for(Int_t i = 0; i<InpEst; i++){
-      for(Int_t k = 0; k<InpUnc; k++){ 
-	m = i + k*InpEst;
-	u = UncSave->operator()(m,m);
-	e = TMath::Abs(Sta->operator()(i,k));
-	x = 0.;
-	if(e > 0.)x = gRandom->Gaus(0., e);
-	if(StaFla == 0){
-	  UncSimu->operator()(m,m) = TMath::Max(0., u+x);
-	}else{
-	  UncSimu->operator()(m,m) = TMath::Abs(u+x);
-	  SgnSimu->operator()(i,k) = TMath::Sign(1.,u+x);
+  // Do the Scan. Simulation N uses its own random number stream, seeded
+  // from SimSee and N, so the result does not depend on the number of
+  // threads. Each thread keeps its own workspace.
+  Int_t NumUse = NumThr;
+  if(NumUse <= 0)NumUse = std::thread::hardware_concurrency();
+  NumUse = TMath::Max(1, TMath::Min(NumUse, NumSim));
+  std::atomic<Int_t> NexSim(0);
+  std::atomic<Int_t> NotPos(0);
+  auto RunSim = [&](){
+    TRandom3 Rnd;
+    TMatrixD UncS(InpEst,InpUnc);
+    TMatrixD SgnS(InpEst,InpUnc);
+    std::vector<TMatrixD> CorS(InpUnc, TMatrixD(InpEst,InpEst));
+    std::vector<const TMatrixD*> CorU(InpUnc);
+    TMatrixD CovS(InpEst,InpEst);
+    TMatrixD HS(InpEst,InpObs);
+    TMatrixD CovResS(InpObs,InpObs);
+    TMatrixD LamS(InpEst,InpObs);
+    TMatrixDSym SymEst(InpEst), SymObs(InpObs);
+    TDecompChol ChlEst(InpEst), ChlObs(InpObs);
+    Double_t x = 0., u = 0., e = 0., val = 0.;
+    for(Int_t N = NexSim++; N<NumSim; N = NexSim++){
+      Rnd.SetSeed(SimulSeed(N));
+
+      // Generate changed uncertainties, save sign changes
+      SgnS.Zero();
+      for(Int_t i = 0; i<InpEst; i++){
+	for(Int_t k = 0; k<InpUnc; k++){ 
+	  u = UncCen(i,k);
+	  e = TMath::Abs(Sta->operator()(i,k));
+	  x = 0.;
+	  if(e > 0.)x = Rnd.Gaus(0., e);
+	  if(StaFla == 0){
+	    UncS(i,k) = TMath::Max(0., u+x);
+	  }else{
+	    UncS(i,k) = TMath::Abs(u+x);
+	    SgnS(i,k) = TMath::Sign(1.,u+x);
+	  }
 	}
       }
-    }
 
-    // Change correlation if needed
-    if(StaFla == 2){
-      m = 0;
-      Int_t    n = 0;
-      Double_t d = 0., small = 0.001;
-      for(Int_t i = 0; i<InpEst; i++){
-	for(Int_t j = i+1; j<InpEst; j++){
-	  for(Int_t k = 0; k<InpUnc; k++){ 
-	    m = i + k*InpEst;
-	    n = j + k*InpEst;
-	    // rho != 0?
-	    if(CorSave->operator()(m,n) != 0.){
-	      // rho != +-1?
-	      d = TMath::Abs(TMath::Abs(CorSave->operator()(m,n)) - 1.);
-	      if(d > small){
-		// CR: 26.07.24
-		//if(N == 0 && NotOne == 0){
-		if(NotOne == 0){
-		  NotOne = 1;
-		  printf("... Blue->SolveScaSta(%2i): Reminder: I will",StaFla);
-		  printf(" only change correlations if rho_ijk == +-1 !! \n");
-		  printf("... Blue->SolveScaSta(%2i): So e.g. not for",StaFla);
-		  printf(" estimates i=(%i,%i)",IsWhichEst(i),IsWhichEst(j));
-		  printf(" and Uncertainty k=%i\n",IsWhichUnc(k));
-		}
-	      }else{
-		if(SgnSimu->operator()(i,k) * SgnSimu->operator()(j,k) < 0.){
-		  CorSimu->operator()(m,n) = -1.*CorSave->operator()(m,n);
-		  CorSimu->operator()(n,m) = CorSimu->operator()(m,n);
-		}
+      // Change correlation if needed, only for rho == +-1
+      for(Int_t k = 0; k<InpUnc; k++)CorU[k] = Cor[k];
+      if(StaFla == 2){
+	for(Int_t k = 0; k<InpUnc; k++){
+	  CorS[k] = *Cor[k];
+	  CorU[k] = &CorS[k];
+	}
+	for(Int_t i = 0; i<InpEst; i++){
+	  for(Int_t j = i+1; j<InpEst; j++){
+	    for(Int_t k = 0; k<InpUnc; k++){ 
+	      if(TMath::Abs(TMath::Abs(CorS[k](i,j)) - 1.) <= 0.001 &&
+		 SgnS(i,k) * SgnS(j,k) < 0.){
+		CorS[k](i,j) = -1.*CorS[k](i,j);
+		CorS[k](j,i) = CorS[k](i,j);
 	      }
 	    }
 	  }
 	}
       }
+
+      // Solve as in FillCov(), FillCovInvert() and Solve()
+      CovS.Zero();
+      for(Int_t k = 0; k<InpUnc; k++){
+	for(Int_t i = 0; i<InpEst; i++){
+	  for(Int_t j = 0; j<InpEst; j++){
+	    CovS(i,j) += UncS(i,k) * CorU[k]->operator()(i,j) * UncS(j,k);
+	  }
+	}
+      }
+      if(CalcInvert(&CovS, &CovS, &SymEst, &ChlEst, "SolveScaSta()") == 0)
+	NotPos++;
+      HS.Mult(CovS, *Uma);
+      CovResS.Mult(*Utr, HS);
+      CalcInvert(&CovResS, &CovResS, &SymObs, &ChlObs, "SolveScaSta()");
+      LamS.Mult(HS, CovResS);
+
+      // Save the individual results
+      for(Int_t n = 0; n<InpObs; n++){
+	val = 0.;
+	for(Int_t i = 0; i<InpEst; i++)val = val + LamS(i,n)*Xva->operator()(i);
+	ValResSimu->operator()(n,N) = val;
+	UncResSimu->operator()(n,N) = TMath::Sqrt(CovResS(n,n));
+      }
     }
-    // Now CorSimu, UncSimu and XvaSimu are filled
-    
-    // Fix and solve
-    ReleaseInp();
-    FixInp();
-    Solve();
-  
-    // Save the individual results
-    for(Int_t n = 0; n<InpObs; n++){
-      ValResSimu->operator()(n,N) = XvaRes->operator()(n);
-      UncResSimu->operator()(n,N) = TMath::Sqrt(CovRes->operator()(n,n));
-    }
+  };
+  if(NumUse == 1){
+    RunSim();
+  }else{
+    std::vector<std::thread> Threads;
+    for(Int_t t = 0; t<NumUse; t++)Threads.emplace_back(RunSim);
+    for(auto& Thread : Threads)Thread.join();
   }
 
   // Print out warning if needed
@@ -1619,12 +1817,14 @@ void Blue::SolveScaSta(const Int_t IScSta){
     printf("... Blue->SolveScaSta(%2i): WARNING some correlations", StaFla);
     printf(" have not been changed, see manual for details\n");
   }
+  if(NotPos > 0){
+    printf("... Blue->SolveScaSta(%2i): WARNING %i of %i simulated",
+	   StaFla, NotPos.load(), NumSim);
+    printf(" covariance matrices are not positive definite\n");
+  }
 
-  // Remove quiet modus
-  SetQuiet(0);
-  
-  // Release the Simulation flag
-  SetIsSimulation(0);
+  // Restore quiet modus
+  SetQuiet(QuiSav);
 
   // Set the Solver flag
   SetIsSolvedScaSta(1);
@@ -1633,10 +1833,6 @@ void Blue::SolveScaSta(const Int_t IScSta){
   if(IsPrintLevel() > 0)PrintScaSta();
 
   // Clean up local vectors and matrices and return
-  SgnSimu->Delete(); SgnSimu = NULL;
-  XvaSave->Delete(); XvaSave = NULL;
-  UncSave->Delete(); UncSave = NULL;
-  CorSave->Delete(); CorSave = NULL;
   XvaResSave->Delete(); XvaResSave = NULL;
   CovResSave->Delete(); CovResSave = NULL;
   return;
@@ -1664,53 +1860,116 @@ void Blue::SolvePosWei(){
   // Solve once
   Solve();
 
-  // Due to de-activation of estimates new estimates can get negative weights
-  // Iterate until all are positive
-  TVectorD* IDeAct = new TVectorD(InpEstOrig);
-  Int_t NDeAct = 1, NumCal = 0, NumDea = 0;
-
+  // Find the estimates to be de-activated without repeating FixInp() and
+  // Solve(): start from the inverse covariance of all estimates, remove all
+  // estimates with negative weights at once by rank-one downdates, see
+  // CalcInvDel(), and recompute the weights, see CalcSolveInv(). Due to the
+  // removal new estimates can get negative weights, iterate until all are
+  // positive. The objective, i.e. the variance of the observables, is
+  // reported at each step
+  TMatrixD* InvAcc = new TMatrixD(InpEst,InpEst);
+  TMatrixD* HAcc   = new TMatrixD(InpEst,InpObs);
+  TMatrixD* CovAcc = new TMatrixD(InpObs,InpObs);
+  TMatrixD* LamAcc = new TMatrixD(InpEst,InpObs);
+  TMatrixD* VecAcc = new TMatrixD(InpEst,1);
+  std::vector<Int_t> ActAcc(InpEst, 1);
+  std::vector<Int_t> IndDea;
+  InvAcc->SetSub(0,0,*CovI);
+  LamAcc->SetSub(0,0,*Lam);
+
+  Int_t NDeAct = 1, NumCal = 0, NumDea = 0, IPosi = 1;
   while(NDeAct > 0){
     NDeAct = 0;
-    // Store estimates i of observable n with negative weights
-    //printf("... Blue->SolvePosWei(): Lam \n"); Lam->Print();
+    // Remove estimates i of observable n with negative weights
     for(Int_t n = 0; n<InpObs; n++){    
-      //printf("... Blue->SolvePosWei(): Next Obs is %2i \n", IsWhichObs(n));
       for(Int_t i = 0; i<InpEst; i++){     
-	if(EstWhichObs(IsWhichEst(i)) == IsWhichObs(n)){
-	  //printf("... Blue->SolvePosWei(): Next Est=%2i(%2i) determines Obs=%2i \n", 
-	  //	 i,IsWhichEst(i),IsWhichObs(n));
-	  if(Lam->operator()(i,n) < 0){
-	    IDeAct->operator()(NDeAct) = IsWhichEst(i);
-	    NDeAct = NDeAct + 1;
+	if(ActAcc[i] == 1 && EstWhichObs(IsWhichEst(i)) == IsWhichObs(n) &&
+	   LamAcc->operator()(i,n) < 0){
+	  if(IsQuiet() == 0){
+	    printf("... Blue->SolvePosWei(): Step %2i: Disable estimate", NumCal+1);
+	    printf(" %2i = %s, weight %+6.4f \n", IsWhichEst(i),
+		   GetNamEst(IsWhichEst(i)).Data(), LamAcc->operator()(i,n));
+	  }
+	  if(IPosi == 1){IPosi = CalcInvDel(InvAcc, &ActAcc[0], i, VecAcc);
+	  }else{ActAcc[i] = 0;
 	  }
+	  IndDea.push_back(IsWhichEst(i));
+	  NDeAct = NDeAct + 1;
 	}
       }
     }
-    // Now deactivate if needed and solve
     if(NDeAct > 0){
-      ReleaseInp();
-      for(Int_t l = 0; l<NDeAct; l++){
-	NumDea = NumDea + 1;
-	SetInActiveEst(static_cast<int>(IDeAct->operator()(l)));
+      if(IPosi == 0)CalcInvAct(InvAcc, &ActAcc[0]);
+      IPosi = 1;
+      CalcSolveInv(InvAcc, HAcc, CovAcc, LamAcc);
+      NumDea = NumDea + NDeAct;
+      NumCal = NumCal + 1;
+      if(IsQuiet() == 0){
+	for(Int_t n = 0; n<InpObs; n++){
+	  printf("... Blue->SolvePosWei(): Step %2i: Observable %2i = %s:", NumCal,
+		 IsWhichObs(n), GetNamObs(IsWhichObs(n)).Data());
+	  printf(" uncertainty %5.3f \n", TMath::Sqrt(CovAcc->operator()(n,n)));
+	}
+      }
+    }
+  }
+  InvAcc->Delete(); InvAcc = NULL;
+  HAcc->Delete(); HAcc = NULL;
+  CovAcc->Delete(); CovAcc = NULL;
+  LamAcc->Delete(); LamAcc = NULL;
+  VecAcc->Delete(); VecAcc = NULL;
+
+  // De-activate the estimates found and solve, this is the only repetition
+  // of FixInp() and Solve()
+  Int_t NumSol = 1;
+  if(NumDea > 0){
+    ReleaseInp();
+    for(const Int_t i : IndDea)SetInActiveEst(i);
+    FixInp();
+    Solve();
+    NumSol = NumSol + 1;
+  }
+
+  // Safety net: should rounding leave a negative weight, continue by
+  // de-activating and solving again
+  NDeAct = 1;
+  while(NDeAct > 0){
+    NDeAct = 0;
+    IndDea.clear();
+    for(Int_t n = 0; n<InpObs; n++){    
+      for(Int_t i = 0; i<InpEst; i++){     
+	if(EstWhichObs(IsWhichEst(i)) == IsWhichObs(n) &&
+	   Lam->operator()(i,n) < 0){
+	  IndDea.push_back(IsWhichEst(i));
+	  NDeAct = NDeAct + 1;
+	}
       }
+    }
+    if(NDeAct > 0){
+      ReleaseInp();
+      for(const Int_t i : IndDea)SetInActiveEst(i);
+      NumDea = NumDea + NDeAct;
       NumCal = NumCal + 1;
       FixInp();
       Solve();
+      NumSol = NumSol + 1;
     }
   }
   
   // Report the findings
-  if(NumCal == 0){
-    printf("... Blue->SolvePosWei(): Not needed all weights are positive \n");
-  }else{
-    printf("... Blue->SolvePosWei(): Succcess after disabling %2i estimates in %2i iterations \n", NumDea, NumCal);
+  if(IsQuiet() == 0){
+    if(NumCal == 0){
+      printf("... Blue->SolvePosWei(): Not needed all weights are positive \n");
+    }else{
+      printf("... Blue->SolvePosWei(): Succcess after disabling %2i estimates in %2i iterations", NumDea, NumCal);
+      printf(" (%2i solves) \n", NumSol);
+    }
   }
 
   // Set the flag
   SetIsSolvedPosWei(1);
 
-  // Clean up and return
-  IDeAct->Delete(); IDeAct = NULL;
+  // Return
   return;
 };
 
@@ -2046,7 +2305,6 @@ void Blue::FillEst(const Int_t i, const Double_t *const x){
     //Xva->Print();
 
     // Uncertainties
-    Int_t IRow;
     Double_t sig = 0, val = 0;
     for(Int_t k = 0; k<InpUncOrig; k++){
       // The individual values
@@ -2058,10 +2316,8 @@ void Blue::FillEst(const Int_t i, const Double_t *const x){
 	val = -1. * x[0] * x[k+1] / 100.;
       }
 
-      double* unc = &val;
-      IRow=i+k*InpEst;
-      //printf("... Blue->FillEst: IRow = %2i, ICol = %2i, val = %5.3f \n",  IRow, IRow, x[k+1]);
-      Unc->InsertRow(IRow,IRow,unc,1);
+      //printf("... Blue->FillEst: i = %2i, k = %2i, val = %5.3f \n",  i, k, x[k+1]);
+      Unc->operator()(i,k) = val;
       // The sum
       sig = sig + val*val;
     }
@@ -2190,10 +2446,8 @@ void Blue::FillCor(const Int_t k, const Double_t *const x){
     };
 
     // Fill into local structures
-    Int_t IRow = kk*InpEst;
-    Int_t ICol = kk*InpEst;
-    Cor->SetSub(IRow,ICol,*F);
-    //Cor->Print();
+    Cor[kk]->SetSub(0,0,*F);
+    //Cor[kk]->Print();
 
     // Cean up
     F->Delete(); F = NULL;
@@ -2232,9 +2486,8 @@ void Blue::FillCor(const Int_t k, const Double_t rho){
 	F->operator()(j,i) = rho;
       }
     }
-    Int_t IRow = k*InpEstOrig;
-    Cor->SetSub(IRow,IRow,*F);
-    //Cor->Print();
+    Cor[k]->SetSub(0,0,*F);
+    //Cor[k]->Print();
 
     // Cean up
     F->Delete(); F = NULL;
@@ -2812,7 +3065,7 @@ Int_t Blue::GetEst(TMatrixD *const UseEst) const {
     for(Int_t i = 0; i<InpEst; i++){
       UseEst->operator()(i,0) = Xva->operator()(i);
       for(Int_t k = 0; k<InpUnc; k++){
-	UseEst->operator()(i,k+1) = Unc->operator()(i+k*InpEst,i+k*InpEst);
+	UseEst->operator()(i,k+1) = Unc->operator()(i,k);
       }
     }
     //UseEst->Print();
@@ -2986,16 +3239,9 @@ Int_t Blue::GetCor(const Int_t k, TMatrixD *const UseCor) const {
   for(Int_t ll = 0; ll<InpUncOrig; ll++){
     if(l == -1 && IsWhichUnc(ll) == k)l = ll;
   }
-  TMatrixD *F = new TMatrixD(InpEst,InpEst);
-  Int_t IRowLow = l*InpEst; 
-  Int_t IRowHig = IRowLow + InpEst-1;
-  Int_t IColLow = IRowLow; 
-  Int_t IColHig = IRowHig;
-  Cor->GetSub(IRowLow, IRowHig, IColLow, IColHig, *F, "S");
-  UseCor->SetSub(0,0,*F);
+  UseCor->SetSub(0,0,*Cor[l]);
 
-  // Clean up and return
-  F->Delete(); F = NULL;
+  // Return
   return 1;
 };
 
@@ -3281,6 +3527,30 @@ Int_t Blue::GetCovRes(Double_t *const RetCovRes) const {
 
 //------------------------------------------------------------------------------
 
+Int_t Blue::GetCovRes(const Int_t k, TMatrixD *const UseCovRes) const {
+  if(IsSolved() == 1){
+    if(k < 0 || k >= InpUnc){
+      printf("... Blue->GetCovRes(%2i): Not an active uncertainty \n", k);
+      return 0;
+    }
+    if(IsPrintLevel() >= 1){
+      printf("... Blue->GetCovRes(%2i): Return covariance matrix", k);
+      printf(" of the result for this source as TMatrixD \n");
+    }
+    // The covariance per source is the k-th diagonal block of CorRes
+    UseCovRes->SetSub(0,0,CorRes->GetSub(k*InpObs,(k+1)*InpObs-1,
+					 k*InpObs,(k+1)*InpObs-1));
+    return 1;
+  }
+
+  // Print failure and return
+  printf("... Blue->GetCovRes(%2i): Presently not available,", k);
+  printf(" call Solve() \n");
+  return 0;
+};
+
+//------------------------------------------------------------------------------
+
 Int_t Blue::GetRhoRes(TMatrixD *const UseRhoRes) const {
   if(IsSolved() == 1){
     if(IsPrintLevel() >= 1){
@@ -3501,6 +3771,98 @@ Int_t Blue::GetCompatObs(Double_t *const RetCompatObs) const {
 
 //------------------------------------------------------------------------------
 
+Int_t Blue::GetNumJac() const {
+  if(IsSolved() == 1){
+    return InpUnc + InpEst*InpUnc;
+  }
+
+  // Print failure and return
+  printf("... Blue->GetNumJac(): Presently not available, call Solve() \n");
+  return 0;
+};
+
+//------------------------------------------------------------------------------
+
+Int_t Blue::GetJacVal(TMatrixD *const UseJacVal) const {
+  if(IsSolved() == 1){
+    if(IsPrintLevel() >= 1){
+      printf("... Blue->GetJacVal: Return the derivatives of the results");
+      printf(" as TMatrixD \n");
+    }
+    CalcJacobian();
+    UseJacVal->ResizeTo(InpObs,GetNumJac());
+    UseJacVal->SetSub(0,0,*JacValRes);
+    return 1;
+  }
+
+  // Print failure and return
+  printf("... Blue->GetJacVal: Presently not available, call Solve() \n");
+  return 0;
+};
+
+//------------------------------------------------------------------------------
+
+Int_t Blue::GetJacVal(Double_t *const RetJacVal) const {
+  if(IsSolved() == 1){
+    if(IsPrintLevel() >= 1){
+      printf("... Blue->GetJacVal: Return the derivatives of the results");
+      printf(" as Double_t array \n");
+    }
+    // The matrix version is the master
+    TMatrixD* Dumm = new TMatrixD(InpObs,GetNumJac());
+    Int_t IRet = GetJacVal(Dumm);
+    MatrixtoDouble(Dumm, RetJacVal);
+    Dumm->Delete(); Dumm = NULL;
+    return IRet;
+  }
+
+  // Print failure and return
+  printf("... Blue->GetJacVal: Presently not available, call Solve() \n");
+  return 0;
+};
+
+//------------------------------------------------------------------------------
+
+Int_t Blue::GetJacCov(TMatrixD *const UseJacCov) const {
+  if(IsSolved() == 1){
+    if(IsPrintLevel() >= 1){
+      printf("... Blue->GetJacCov: Return the derivatives of the covariance");
+      printf(" of the results as TMatrixD \n");
+    }
+    CalcJacobian();
+    UseJacCov->ResizeTo(InpObs*InpObs,GetNumJac());
+    UseJacCov->SetSub(0,0,*JacCovRes);
+    return 1;
+  }
+
+  // Print failure and return
+  printf("... Blue->GetJacCov: Presently not available, call Solve() \n");
+  return 0;
+};
+
+//------------------------------------------------------------------------------
+
+Int_t Blue::GetJacCov(Double_t *const RetJacCov) const {
+  if(IsSolved() == 1){
+    if(IsPrintLevel() >= 1){
+      printf("... Blue->GetJacCov: Return the derivatives of the covariance");
+      printf(" of the results as Double_t array \n");
+    }
+    // The matrix version is the master
+    TMatrixD* Dumm = new TMatrixD(InpObs*InpObs,GetNumJac());
+    Int_t IRet = GetJacCov(Dumm);
+    MatrixtoDouble(Dumm, RetJacCov);
+    Dumm->Delete(); Dumm = NULL;
+    return IRet;
+  }
+
+  // Print failure and return
+  printf("... Blue->GetJacCov: Presently not available, call Solve() \n");
+  return 0;
+};
+
+//------------------------------------------------------------------------------
+
 Int_t Blue::GetInspectLike(TMatrixD *const UseInsLik) const {
   if(IsInspectedLike() == 1){
     if(IsPrintLevel() >= 1){
@@ -3601,6 +3963,67 @@ Int_t Blue::GetAccImpIndEst(const Int_t n, Int_t *const IndEst) const{
   
 //------------------------------------------------------------------------------
 
+Int_t Blue::GetNumRelUnc() const {
+  if(IsSolvedRelUnc() == 1){
+    if(IsPrintLevel() >= 1){
+      printf("... Blue->GetNumRelUnc: Number of iterations = %3i \n",
+	     NumRelUnc);
+    }
+    return NumRelUnc;
+  }
+
+  // Print failure and return
+  printf("... Blue->GetNumRelUnc: Presently not available,");
+  printf(" call SolveRelUnc() \n");
+  return -1;
+};
+
+//------------------------------------------------------------------------------
+
+Int_t Blue::GetResRelUnc(TVectorD *const UseResRel) const {
+  if(IsSolvedRelUnc() == 1){
+    if(IsPrintLevel() >= 1){
+      printf("... Blue->GetResRelUnc: Return the largest relative change");
+      printf(" per iteration in %% as TVectorD\n");
+    }
+    UseResRel->ResizeTo(NumRelUnc);
+    for(Int_t l = 0; l<NumRelUnc; l++){
+      UseResRel->operator()(l) = ResRelUnc->operator()(l);
+    }
+    return 1;
+  }
+
+  // Print failure and return
+  printf("... Blue->GetResRelUnc: Presently not available,");
+  printf(" call SolveRelUnc() \n");
+  return 0;
+};
+//------------------------------------------------------------------------------
+
+Int_t Blue::GetAccImpLeaOut(TMatrixD *const UseVal, 
+			    TMatrixD *const UseUnc) const {
+  if(IsSolvedAccImp() == 1){
+    if(IsPrintLevel() >= 1){
+      printf("... Blue->GetAccImpLeaOut: Return the leave-one-out");
+      printf(" results as TMatrixD\n");
+    }
+    for(Int_t i = 0; i<InpEst; i++){
+      for(Int_t n = 0; n<InpObs; n++){
+	UseVal->operator()(i,n) = ValLea->operator()(i,n);
+	UseUnc->operator()(i,n) = UncLea->operator()(i,n);
+      }
+    }
+    return 1;
+  }
+
+  // Print failure and return
+  printf("... Blue->GetAccImpLeaOut: Presently not available,");
+  printf(" call SolveAccImp() \n");
+  return 0;
+};
+
+//------------------------------------------------------------------------------
+
 Int_t Blue::GetNumScaFac() const {
   if(IsFixedInp() == 1){
     if(IsPrintLevel() >= 1){
@@ -4102,7 +4525,7 @@ void Blue::SetRelUnc(const Int_t k){
       for(Int_t i = 0; i<InpEstOrig; i++){	
 	if(IsActiveEst(i) == 1){
 	  Value = XvaOrig->operator()(i);
-	  Uncer = UncOrig->operator()(k*InpEstOrig+i, k*InpEstOrig+i);
+	  Uncer = UncOrig->operator()(i,k);
 	  if(k == 0){
 	    ActCof[1] = (Uncer*Uncer) / (TMath::Abs(Value));
 	    ActCof[2] = 0;
@@ -4222,10 +4645,86 @@ void Blue::SetNotRelUnc(const Int_t k){
 };
 
 //---------------------------------------------------------------------------
-// Control Printout
+// Control SolveScaSta
 //---------------------------------------------------------------------------
 
-void Blue::SetPrintLevel(const Int_t p){
+void Blue::SetNumSim(const Int_t n){
+  if(IsSolvedScaSta() == 1){
+    printf("... Blue->SetNumSim(%5i): IGNORED SolveScaSta() was called.", n);
+    printf(" Call ReleaseInp() or ResetInp() \n");
+    return;
+  }
+  if(n < 1){
+    printf("... Blue->SetNumSim(%5i): IGNORED I need at least one simulation \n", n);
+    return;
+  }
+  NumSim = n;
+  if(IsPrintLevel() >= 1){
+    printf("... Blue->SetNumSim(%5i): SolveScaSta() will do %i simulations \n", n, n);
+  }
+
+  // Return
+  return;
+};
+
+//------------------------------------------------------------------------------
+
+void Blue::SetSeeSim(const Int_t IniSee){
+  if(IniSee < 1){
+    printf("... Blue->SetSeeSim(%i): IGNORED The seed must be positive \n", IniSee);
+    return;
+  }
+  SimulInit(IniSee);
+
+  // Return
+  return;
+};
+
+//------------------------------------------------------------------------------
+
+void Blue::SetNumThr(const Int_t n){
+  // n <= 0 uses all available cores. With more than one thread the
+  // caller must have called ROOT::EnableThreadSafety() before solving
+  NumThr = n;
+  if(IsPrintLevel() >= 1){
+    printf("... Blue->SetNumThr(%3i): SolveScaSta() and SolveScaRho() will use", n);
+    if(n > 0){printf(" %i threads \n", n);
+    }else{printf(" all available cores \n");
+    }
+  }
+
+  // Return
+  return;
+};
+
+//---------------------------------------------------------------------------
+// Control SolveRelUnc
+//---------------------------------------------------------------------------
+
+void Blue::SetAccRelUnc(const Int_t n){
+  // n = 0 is the plain iteration
+  if(n < 0){
+    printf("... Blue->SetAccRelUnc(%3i): IGNORED", n);
+    printf(" I expect a non-negative depth \n");
+    return;
+  }
+  AndRelUnc = n;
+  if(IsPrintLevel() >= 1){
+    printf("... Blue->SetAccRelUnc(%3i): SolveRelUnc() will", n);
+    if(n > 0){printf(" use the last %i iterations \n", n);
+    }else{printf(" not accelerate the iteration \n");
+    }
+  }
+
+  // Return
+  return;
+};
+
+//---------------------------------------------------------------------------
+// Control Printout
+//---------------------------------------------------------------------------
+
+void Blue::SetPrintLevel(const Int_t p){
   if(p >= 0 || p <= 2){
     IPrint = p;
     if(p > 0){
@@ -4293,10 +4792,10 @@ void Blue::SetFormat(const TString ForVal, const TString ForUnc,
 
 void Blue::SetNoRootSetup(){
 
-  // Was already set by FixInp()
+  // Was already set by the first graphics
   if(IndRoo == -2){
     printf("... Blue->SetNoRootSetup(): IGNORED this has to be called");
-    printf("before the first call to FixInp()\n");
+    printf(" before the first graphics is produced\n");
     return;
   }
 
@@ -4658,10 +5157,10 @@ void Blue::PrintEst(const Int_t i) const {
     for(Int_t k = 0; k<InpUnc; k++){
       if(k == 0){
 	Format = " (" + DefUnc;
-	printf(Format,Unc->operator()(j+k*InpEst,j+k*InpEst));
+	printf(Format,Unc->operator()(j,k));
       }else{
 	Format = " +- " + DefUnc;
-	printf(Format,Unc->operator()(j+k*InpEst,j+k*InpEst));
+	printf(Format,Unc->operator()(j,k));
       }
       if(k == InpUnc-1)printf(")");
     }
@@ -4805,26 +5304,11 @@ void Blue::PrintCov(const Int_t k) const {
 	  if(l == -1 && IsWhichUnc(ll) == k)l = ll;
 	}
 	printf("... Blue->PrintCov(%2i): Covariance matrix for: %s \n",k,GetNamUnc(k).Data());
-	TMatrixD *F = new TMatrixD(InpEst,InpEst);
-	TMatrixD *G = new TMatrixD(InpEst,InpEst);
 	TMatrixD *H = new TMatrixD(InpEst,InpEst);
-	Int_t IRowLow = l*InpEst; 
-	Int_t IRowHig = IRowLow + InpEst-1;
-	Int_t IColLow = IRowLow; 
-	Int_t IColHig = IRowHig;
-	//  printf("... %3i, %3i, %3i, %3i \n",IRowLow, IColLow, IRowHig, IColHig);
-	// The correlation matrix
-	Cor->GetSub(IRowLow, IRowHig, IColLow, IColHig, *F, "S");
-	// The uncertainty matrix
-	Unc->GetSub(IRowLow, IRowHig, IColLow, IColHig, *G, "S");
 	//Calculate the covariance for this source
-	Unc->GetSub(IRowLow, IRowHig, IColLow, IColHig, *H, "S");
-	H->operator*=(*F);
-	H->operator*=(*G);
+	FillCovSource(l, H);
 	H->Print();
 	// Clean up
-	F->Delete(); F = NULL;
-	G->Delete(); G = NULL;
 	H->Delete(); H = NULL;
       }else{
 	printf("... Blue->PrintCov(%2i): Not an active uncertainty \n", k);
@@ -5003,6 +5487,8 @@ void Blue::PrintCompatEst(const TString FilNam) const {
     P->Delete(); P = NULL;
     return;
   }
+  std::lock_guard<std::mutex> RooLck(RooMtx);
+  SetupRoot();
 
   // Report matrices
   //printf("... Blue->PrintCompatEst(): C: \n"); C->Print();
@@ -5522,6 +6008,60 @@ void Blue::PrintCompatObs() const {
 
 //------------------------------------------------------------------------------
 
+void Blue::PrintJacobian() const {
+  if(IsSolved() == 0){
+    printf("... Blue->PrintJacobian(): Presently not available, call Solve() \n");
+    return;
+  }
+
+  // Get the derivatives
+  const Int_t NumJac = GetNumJac();
+  CalcJacobian();
+  const TMatrixD* JacVal = JacValRes;
+  const TMatrixD* JacCov = JacCovRes;
+
+  // Print them per observable, ranked by the derivative of the value
+  printf("... Blue->PrintJacobian(): The derivatives of the results with");
+  printf(" respect to the correlations (rho) and uncertainties (unc) \n");
+  std::vector<Int_t> IndJac(NumJac);
+  std::vector<Double_t> DerSig(NumJac);
+  Double_t SigRes = 0;
+  Int_t i = 0, k = 0;
+  for(Int_t n = 0; n<InpObs; n++){
+    SigRes = TMath::Sqrt(CovRes->operator()(n,n));
+    printf("... Blue->PrintJacobian(): Observable %2i = %s:",
+	   IsWhichObs(n), GetNamObs(IsWhichObs(n)).Data());
+    printf(" %5.3f +- %5.3f \n", XvaRes->operator()(n), SigRes);
+    for(Int_t p = 0; p<NumJac; p++){
+      IndJac[p] = p;
+      DerSig[p] = 0.5*JacCov->operator()(n*InpObs+n,p)/SigRes;
+    }
+    std::stable_sort(IndJac.begin(), IndJac.end(), [&](const Int_t p, const Int_t q){
+      return TMath::Abs(JacVal->operator()(n,p)) > TMath::Abs(JacVal->operator()(n,q));
+    });
+    for(const Int_t p : IndJac){
+      if(JacVal->operator()(n,p) == 0 && DerSig[p] == 0)continue;
+      if(p < InpUnc){
+	printf("... Blue->PrintJacobian(): rho %-10s               ",
+	       GetNamUnc(IsWhichUnc(p)).Data());
+      }else{
+	i = (p-InpUnc) / InpUnc;
+	k = (p-InpUnc) % InpUnc;
+	printf("... Blue->PrintJacobian(): unc %-10s %-14s",
+	       GetNamUnc(IsWhichUnc(k)).Data(), GetNamEst(IsWhichEst(i)).Data());
+      }
+      printf(" d(value) = %+9.3e, d(sigma) = %+9.3e \n",
+	     JacVal->operator()(n,p), DerSig[p]);
+    }
+    printf("... Blue->PrintJacobian():\n");
+  }
+
+  // Return
+  return;
+};
+
+//------------------------------------------------------------------------------
+
 void Blue::PrintChiPro() const {
   if(IsSolved() == 1){
     printf("... Blue->PrintChiPro(): ChiQua = %5.3f for NDof = %2i", ChiQua, NumDof);
@@ -5659,9 +6199,9 @@ void Blue::PrintAccImp() const {
 	    printf("... Blue->PrintAccImp(): %2i = %s:", NexImp, GetNamEst(NexImp).Data());
 	    // Print the individual estimates
 	    printf(" %5.3f", Xva->operator()(IndNex));
-	    printf(" +- %5.3f", Unc->operator()(IndNex,IndNex));
+	    printf(" +- %5.3f", Unc->operator()(IndNex,0));
 	    dumm = TMath::Sqrt(TMath::Power(Sig->operator()(IndNex),2.0)-
-			       TMath::Power(Unc->operator()(IndNex,IndNex),2.0));
+			       TMath::Power(Unc->operator()(IndNex,0),2.0));
 	    printf(" +- %5.3f", dumm);
 
 	    // Print the correlation
@@ -5719,6 +6259,39 @@ void Blue::PrintAccImp() const {
 
 //------------------------------------------------------------------------------
 
+void Blue::PrintAccImpLeaOut() const {
+  if(IsSolvedAccImp() == 1){
+    printf("... Blue->PrintAccImpLeaOut(): The combination when leaving out");
+    printf(" one estimate at a time \n");
+    for(Int_t n = 0; n<InpObs; n++){
+      printf("... Blue->PrintAccImpLeaOut(): Observable %2i = %s:", 
+	     IsWhichObs(n), GetNamObs(IsWhichObs(n)).Data());
+      printf(" All estimates yield %5.3f +- %5.3f \n",
+	     XvaRes->operator()(n), TMath::Sqrt(CovRes->operator()(n,n)));
+      for(Int_t i = 0; i<InpEst; i++){
+	printf("... Blue->PrintAccImpLeaOut(): Without %2i = %s:",
+	       IsWhichEst(i), GetNamEst(IsWhichEst(i)).Data());
+	if(UncLea->operator()(i,n) < 0){
+	  printf(" Only estimate of observable %2i \n", 
+		 EstWhichObs(IsWhichEst(i)));
+	}else{
+	  printf(" %5.3f +- %5.3f, shift = %6.3f \n",
+		 ValLea->operator()(i,n), UncLea->operator()(i,n),
+		 ValLea->operator()(i,n) - XvaRes->operator()(n));
+	}
+      }
+      printf("... Blue->PrintAccImpLeaOut():\n");
+    }
+  }else{
+    printf("... Blue->PrintAccImpLeaOut(): Presently not available, call SolveAccImp() \n");
+  }
+
+  // Return
+  return;
+};
+
+//------------------------------------------------------------------------------
+
 void Blue::PrintScaRho() const {
   const TString FilNam = "NoGraphWanted";
   PrintScaRho(FilNam);
@@ -5874,6 +6447,8 @@ void Blue::PrintScaRho(const TString FilNam) const {
 
   // Return if no plots wanted
   if(FilNam == "NoGraphWanted")return;
+  std::lock_guard<std::mutex> RooLck(RooMtx);
+  SetupRoot();
 
   //
   // ------------- Now do the figures
@@ -6190,6 +6765,9 @@ void Blue::PrintScaSta(const TString FilNam,
     return;
   }
 
+  // The histograms are named and registered in gROOT, even without plots
+  std::lock_guard<std::mutex> RooLck(RooMtx);
+
   // Helpers for formatting
   char Buffer[150];
   TString Format = "The format is " + DefVal;
@@ -6403,6 +6981,7 @@ void Blue::PrintScaSta(const TString FilNam,
 
   // Return if no plots wanted
   if(FilNam == "NoGraphWanted")return;
+  SetupRoot();
 
   // Book Canvases
   TString  FilPdf = "to be filled later";
@@ -6952,6 +7531,10 @@ void Blue::DrawSens(const Double_t xv1, const Double_t xv2, const Double_t sv1,
 		    const Double_t sv2, const Double_t rho, const TString FilNam,
 		    const Int_t IndFig) const {
 
+  // Only graphics
+  std::lock_guard<std::mutex> RooLck(RooMtx);
+  SetupRoot();
+
   char Buffer[150];
   TString Format = "The format %5.2f";
   TString TxtPri = "To be filled later";
@@ -7346,18 +7929,11 @@ void Blue::InspectLike(const Int_t n, const TString FilNam) {
   // Fill the type of likelihood
   LikRes->operator()(na,6) = static_cast<Double_t>(LikFla);
 
-  // Variable for the names
-  char AnyName[80];
-
-  // Variables for the functions
-  Double_t sigx = 0, xlow =     0, xhig = 0, nsig = 5;
-  Double_t xste = 0, nste = 10000, xact = 0, fact = 0;
-  Double_t par0 = static_cast<Double_t>(n);
-  Double_t par1 = static_cast<Double_t>(InpEst);
-
   // Variables for the likelihood scan
-  Double_t LikMax = 0, LogLik = 0, LxxMax = 0, BluMax = 0, BxxMax = 0;
-  Double_t LikLow = 0, LogBlu = 0, LikHig = 0, BluLow = 0, BluHig = 0;
+  Double_t sigx = 0, xlow = 0, xhig = 0, nsig = 5, xste = 0;
+  Int_t    nste = 10000, IFail = 0;
+  Double_t LikMax = 0, LogLik = 0, LxxMax = 0, BluMax = 0, LogBlu = 0, BxxMax = 0;
+  Double_t LikLow = 0, LikHig = 0, BluLow = 0, BluHig = 0;
 
   // Set the x-axis limits and the step size
   sigx = TMath::Sqrt(CovRes->operator()(na,na));
@@ -7365,55 +7941,24 @@ void Blue::InspectLike(const Int_t n, const TString FilNam) {
   xhig = XvaRes->operator()(na) + nsig*sigx;
   xste = (xhig-xlow)/nste;
 
-  // The garbage collector
-  TF1* TF1Del;
-
-  // Define the likelihood function
-  TF1Del = (TF1*) gROOT->GetListOfFunctions()->FindObject("FuncLike");
-  if(TF1Del)delete TF1Del;
-  TF1* fLike = new TF1("FuncLike",[this](double *x, double *p) { return this->Likelihood(x, p); },xlow,xhig,3);
-  fLike->SetParameter(0, par0);
-  fLike->SetParameter(1, par1);
-  fLike->SetParameter(2,   1.);
-  fLike->SetNpx(100);
-  fLike->SetLineColor(kRed);
-  if(DefUni == "None"){sprintf(AnyName,"%s",GetNamObs(n).Data());
-  }else{sprintf(AnyName,"%s [%s]",GetNamObs(n).Data(),DefUni.Data());
-  }
-  fLike->GetXaxis()->SetTitle(AnyName);
-  fLike->GetYaxis()->SetTitleOffset(1.8);
-  sprintf(AnyName,"pdf(Est_{i}, %s)", GetNamObs(n).Data()); 
-  fLike->GetYaxis()->SetTitle(AnyName);
-
-  // Get the maximum of the likelihood and its x value
-  LxxMax = fLike->GetMaximumX(xlow,xhig);
-  LikMax = fLike->GetMaximum(xlow,xhig);
-  LogLik = -2.*TMath::Log(LikMax);
-
-  // Get the aymmetric uncertainties of the likelihood
-  LikLow = xhig;
-  xact   = LxxMax;
-  while(LikLow == xhig){
-    xact = xact - xste;
-    fact = -2.*TMath::Log(fLike->Eval(xact));
-    if(fact > LogLik + 1)LikLow = xact;
-    if(xact < xlow){
-      LikLow = xlow;
-      printf("... Blue->InspectLike(%2i): Failed: No lower uncertainty found", n);
-      printf(" for the likelihood within plot range. Set to %5.3f \n", LikLow);
-    }
-  }
-  LikHig = xlow;
-  xact   = LxxMax;
-  while(LikHig == xlow){
-    xact = xact + xste;
-    fact = -2.*TMath::Log(fLike->Eval(xact));
-    if(fact > LogLik + 1)LikHig = xact;
-    if(xact > xhig){
-      LikHig = xhig;
-      printf("... Blue->InspectLike(%2i): Failed: No upper uncertainty found", n);
-      printf(" for the likelihood within plot range. Set to %5.3f \n", LikHig);
-    }
+  // Evaluate -2 ln(L) of the likelihood and of BLUE on the grid of x values,
+  // the functions are only needed for the plots
+  std::vector<Double_t> GrdLik(nste+1), GrdBlu(nste+1);
+  CalcLikScan(n, 1, xlow, xste, nste, &GrdLik[0]);
+  CalcLikScan(n, 0, xlow, xste, nste, &GrdBlu[0]);
+
+  // Get the maximum of the likelihood, its x value and its aymmetric
+  // uncertainties
+  IFail = CalcLikInt(&GrdLik[0], nste, xlow, xste,
+		     &LxxMax, &LogLik, &LikLow, &LikHig);
+  LikMax = TMath::Exp(-0.5*LogLik);
+  if(IFail % 2 == 1){
+    printf("... Blue->InspectLike(%2i): Failed: No lower uncertainty found", n);
+    printf(" for the likelihood within plot range. Set to %5.3f \n", LikLow);
+  }
+  if(IFail >= 2){
+    printf("... Blue->InspectLike(%2i): Failed: No upper uncertainty found", n);
+    printf(" for the likelihood within plot range. Set to %5.3f \n", LikHig);
   }
 
   // Fill the matrix
@@ -7423,45 +7968,17 @@ void Blue::InspectLike(const Int_t n, const TString FilNam) {
   printf("... Blue->InspectLike(%2i): L_Like(%5.3f) = %6.3e, %+5.3f < x < %+5.3f ==> %5.3f(+-%5.3f) \n",
 	 n,LxxMax,LikMax,LikLow-LxxMax,LikHig-LxxMax,LxxMax,0.5*(LikHig-LikLow));
 
-  // Define the BLUE function
-  TF1Del = (TF1*) gROOT->GetListOfFunctions()->FindObject("FuncBlue");
-  if(TF1Del)delete TF1Del;
-  TF1* fBlue = new TF1("FuncBlue",[this](double *x, double *p) { return this->Likelihood(x, p); },xlow,xhig,3);
-  fBlue->SetParameter(0, par0);
-  fBlue->SetParameter(1, par1);
-  fBlue->SetParameter(2,   0.);
-  fBlue->SetNpx(100);
-  fBlue->SetLineColor(kBlue);
-
-  // Get the maximum of the BLUE function and its x value
-  BxxMax = fBlue->GetMaximumX(xlow,xhig);
-  BluMax = fBlue->GetMaximum(xlow,xhig);
-  LogBlu = -2.*TMath::Log(BluMax);
-
-  // Get the uncertainties of the BLUE function
-  BluLow = xhig; 
-  xact   = BxxMax;
-  while(BluLow == xhig){
-    xact = xact - xste;
-    fact = -2.*TMath::Log(fBlue->Eval(xact));
-    if(fact > LogBlu + 1)BluLow = xact;
-    if(xact < xlow){
-      BluLow = xlow;
-      printf("... Blue->InspectLike(%2i): Failed: No lower uncertainty found", n);
-      printf(" for BLUE within plot range. Set to %5.3f \n", BluLow);
-    }
-  }
-  BluHig = xlow;
-  xact   = BxxMax;
-  while(BluHig == xlow){
-    xact = xact + xste;
-    fact = -2.*TMath::Log(fBlue->Eval(xact));
-    if(fact > LogBlu + 1)BluHig = xact;
-    if(xact > xhig){
-      BluHig = xhig;
-      printf("... Blue->InspectLike(%2i): Failed: No upper uncertainty found", n);
-      printf(" for BLUE within plot range. Set to %5.3f \n", BluHig);
-    }
+  // Get the maximum of the BLUE function, its x value and its uncertainties
+  IFail = CalcLikInt(&GrdBlu[0], nste, xlow, xste,
+		     &BxxMax, &LogBlu, &BluLow, &BluHig);
+  BluMax = TMath::Exp(-0.5*LogBlu);
+  if(IFail % 2 == 1){
+    printf("... Blue->InspectLike(%2i): Failed: No lower uncertainty found", n);
+    printf(" for BLUE within plot range. Set to %5.3f \n", BluLow);
+  }
+  if(IFail >= 2){
+    printf("... Blue->InspectLike(%2i): Failed: No upper uncertainty found", n);
+    printf(" for BLUE within plot range. Set to %5.3f \n", BluHig);
   }
 
   // Fill the matrix
@@ -7475,6 +7992,43 @@ void Blue::InspectLike(const Int_t n, const TString FilNam) {
   
   // Do the plots if wanted
   if(FilNam != "NoGraphWanted"){
+    std::lock_guard<std::mutex> RooLck(RooMtx);
+    SetupRoot();
+
+    // Variable for the names
+    char AnyName[80];
+    Double_t par0 = static_cast<Double_t>(n);
+    Double_t par1 = static_cast<Double_t>(InpEst);
+
+    // The garbage collector
+    TF1* TF1Del;
+
+    // Define the likelihood function
+    TF1Del = (TF1*) gROOT->GetListOfFunctions()->FindObject("FuncLike");
+    if(TF1Del)delete TF1Del;
+    TF1* fLike = new TF1("FuncLike",[this](double *x, double *p) { return this->Likelihood(x, p); },xlow,xhig,3);
+    fLike->SetParameter(0, par0);
+    fLike->SetParameter(1, par1);
+    fLike->SetParameter(2,   1.);
+    fLike->SetNpx(100);
+    fLike->SetLineColor(kRed);
+    if(DefUni == "None"){sprintf(AnyName,"%s",GetNamObs(n).Data());
+    }else{sprintf(AnyName,"%s [%s]",GetNamObs(n).Data(),DefUni.Data());
+    }
+    fLike->GetXaxis()->SetTitle(AnyName);
+    fLike->GetYaxis()->SetTitleOffset(1.8);
+    sprintf(AnyName,"pdf(Est_{i}, %s)", GetNamObs(n).Data()); 
+    fLike->GetYaxis()->SetTitle(AnyName);
+
+    // Define the BLUE function
+    TF1Del = (TF1*) gROOT->GetListOfFunctions()->FindObject("FuncBlue");
+    if(TF1Del)delete TF1Del;
+    TF1* fBlue = new TF1("FuncBlue",[this](double *x, double *p) { return this->Likelihood(x, p); },xlow,xhig,3);
+    fBlue->SetParameter(0, par0);
+    fBlue->SetParameter(1, par1);
+    fBlue->SetParameter(2,   0.);
+    fBlue->SetNpx(100);
+    fBlue->SetLineColor(kBlue);
 
     // Define the canvas     
     sprintf(AnyName,"%s_CanvLike_%i",FilNam.Data(),n);
@@ -7553,12 +8107,12 @@ void Blue::InspectLike(const Int_t n, const TString FilNam) {
     sprintf(ObsNum,"%i",n);
     TString OutFil = FilNam + "_InsLik_Obs_" + ObsNum + ".pdf";
     CanLik->Print(OutFil);
-  }
 
-  // Clean up    
-  // gROOT->GetListOfFunctions()->Print();
-  delete fLike; fLike = NULL;
-  delete fBlue; fBlue = NULL;
+    // Clean up    
+    // gROOT->GetListOfFunctions()->Print();
+    delete fLike; fLike = NULL;
+    delete fBlue; fBlue = NULL;
+  }
 
   // Set the Flag and return
   SetIsInspectLike(1);
@@ -7922,7 +8476,7 @@ void Blue::LatexResult(const TString FilNam, const TString ForVal,
     
     // Estimates
     for(Int_t i = 0; i<InpEst; i++){
-      Sys = Unc->operator()(i+k*InpEst,i+k*InpEst);
+      Sys = Unc->operator()(i,k);
       Pre = Sta->operator()(i,k);
       if(IndShi >= 1)Shi = Sgn->operator()(i,k);
       if(k > 0)SysEst->operator()(i) = SysEst->operator()(i) + Sys*Sys;
@@ -9714,7 +10268,7 @@ void Blue::DisplayResult(const Int_t n, const TString FilNam,
   for(Int_t i = 0; i<InpEst; i++){
     if(EstWhichObs(IsWhichEst(i)) == n){
       ind = ind + 1;
-      Stat[ind] = Unc->operator()(i+0*InpEst,i+0*InpEst);
+      Stat[ind] = Unc->operator()(i,0);
     }
   }
 
@@ -9722,7 +10276,7 @@ void Blue::DisplayResult(const Int_t n, const TString FilNam,
   for(Int_t k = 1; k<InpUnc; k++){
     for(Int_t i = 0; i<InpEst; i++){
       if(EstWhichObs(IsWhichEst(i)) == n){
-	Sys = Unc->operator()(i+k*InpEst,i+k*InpEst);
+	Sys = Unc->operator()(i,k);
 	SysEst->operator()(i) = SysEst->operator()(i) + Sys*Sys;
       }
     }
@@ -10092,6 +10646,11 @@ void Blue::Construct(const Int_t NumEst, const Int_t NumUnc, const Int_t NumObs,
   // Array of coefficients forBLUE with relative uncertainties
   Cof  = new TMatrixD(InpEstOrig*InpUncOrig,MaxCof);
 
+  // Acceleration and history of SolveRelUnc
+  AndRelUnc = 3;
+  NumRelUnc = 0;
+  ResRelUnc = new TVectorD(MaxRelUnc);
+
   // Reset list of importance and the steering flag for SolveAccImp
   PreAcc = 1.;
   IntAcc = 0;
@@ -10103,6 +10662,8 @@ void Blue::Construct(const Int_t NumEst, const Int_t NumUnc, const Int_t NumObs,
   UncImp = new TMatrixD(InpEstOrig,InpObsOrig);
   StaImp = new TMatrixD(InpEstOrig,InpObsOrig);
   SysImp = new TMatrixD(InpEstOrig,InpObsOrig);
+  ValLea = new TMatrixD(InpEstOrig,InpObsOrig);
+  UncLea = new TMatrixD(InpEstOrig,InpObsOrig);
 
   // The arrays for PlotRes
   Indx = new Int_t[InpEstOrig+1];
@@ -10138,19 +10699,16 @@ void Blue::Construct(const Int_t NumEst, const Int_t NumUnc, const Int_t NumObs,
   // Save harbor for all inputs
   XvaOrig = new TVectorD(InpEstOrig);
   SigOrig = new TVectorD(InpEstOrig);
-  UncOrig = new TMatrixD(InpEstOrig*InpUncOrig,InpEstOrig*InpUncOrig);
-  CorOrig = new TMatrixD(InpEstOrig*InpUncOrig,InpEstOrig*InpUncOrig);
+  UncOrig = new TMatrixD(InpEstOrig,InpUncOrig);
+  CorOrig = new TMatrixD*[InpUncOrig];
+  for(Int_t k = 0; k<InpUncOrig; k++)CorOrig[k] = new TMatrixD(InpEstOrig,InpEstOrig);
   UmaOrig = new TMatrixD(InpEstOrig,InpObsOrig);
   UtrOrig = new TMatrixD(InpObsOrig,InpEstOrig);
   StaOrig = new TMatrixD(InpEstOrig,InpUncOrig);
   SgnOrig = new TMatrixD(InpEstOrig,InpUncOrig);
 
-  // Structures to allow for a simulation
-  XvaSimu = new TVectorD(InpEstOrig);
-  UncSimu = new TMatrixD(InpEstOrig*InpUncOrig,InpEstOrig*InpUncOrig);
-  CorSimu = new TMatrixD(InpEstOrig*InpUncOrig,InpEstOrig*InpUncOrig);
-
   // The matrix that holds the results
+  NumSim = 1000;
   ValResSimu = new TMatrixD(InpObs,NumSim);
   UncResSimu = new TMatrixD(InpObs,NumSim);
   StaResSimu = new TMatrixD(InpObs,StaPar);
@@ -10160,8 +10718,10 @@ void Blue::Construct(const Int_t NumEst, const Int_t NumUnc, const Int_t NumObs,
   Sig = new TVectorD(InpEstOrig);
 
   // Matrices to do the job
-  Unc  = new TMatrixD(InpEstOrig*InpUncOrig,InpEstOrig*InpUncOrig);
-  Cor  = new TMatrixD(InpEstOrig*InpUncOrig,InpEstOrig*InpUncOrig);
+  // Uncertainties (estimate,source) and one correlation matrix per source
+  Unc  = new TMatrixD(InpEstOrig,InpUncOrig);
+  Cor  = new TMatrixD*[InpUncOrig];
+  for(Int_t k = 0; k<InpUncOrig; k++)Cor[k] = new TMatrixD(InpEstOrig,InpEstOrig);
   Cov  = new TMatrixD(InpEstOrig,InpEstOrig);
   CovI = new TMatrixD(InpEstOrig,InpEstOrig);
   Rho  = new TMatrixD(InpEstOrig,InpEstOrig);
@@ -10175,6 +10735,27 @@ void Blue::Construct(const Int_t NumEst, const Int_t NumUnc, const Int_t NumObs,
   CorRes = new TMatrixD(InpObsOrig*InpUncOrig,InpObsOrig*InpUncOrig);
   CovRes = new TMatrixD(InpObsOrig,InpObsOrig);
   RhoRes = new TMatrixD(InpObsOrig,InpObsOrig);
+  IsJacRes  = 0;
+  JacValRes = new TMatrixD(InpObsOrig,InpUncOrig+InpEstOrig*InpUncOrig);
+  JacCovRes = new TMatrixD(InpObsOrig*InpObsOrig,InpUncOrig+InpEstOrig*InpUncOrig);
+
+  // Workspace
+  WrkEst = InpEstOrig;
+  WrkObs = InpObsOrig;
+  WrkCor = new TMatrixD(InpEstOrig,InpEstOrig);
+  WrkH = new TMatrixD(InpEstOrig,InpObsOrig);
+  WrkI = new TMatrixD(InpEstOrig,InpEstOrig);
+  WrkJ = new TMatrixD(InpEstOrig,InpObsOrig);
+  WrkK = new TMatrixD(InpObsOrig,InpEstOrig);
+  WrkL = new TMatrixD(InpObsOrig,InpObsOrig);
+  WrkM = new TMatrixD(InpEstOrig,1);
+  WrkN = new TMatrixD(InpEstOrig,1);
+  WrkO = new TMatrixD(1,InpEstOrig);
+  WrkP = new TMatrixD(1,1);
+  WrkSym[0] = new TMatrixDSym(InpEstOrig);
+  WrkSym[1] = new TMatrixDSym(InpObsOrig);
+  WrkChl[0] = new TDecompChol(InpEstOrig);
+  WrkChl[1] = new TDecompChol(InpObsOrig);
 
   // Chiq information of the results
   ChiQua = 0;
@@ -10212,6 +10793,8 @@ void Blue::Construct(const Int_t NumEst, const Int_t NumUnc, const Int_t NumObs,
 
   // Variables for the simulation
   IsSeeded = 0;
+  SimSee = 123456;
+  NumThr = 0;
 
   // Switch off quiet mode
   SetQuiet(0);
@@ -10240,9 +10823,10 @@ void Blue::Construct(const Int_t NumEst, const Int_t NumUnc, const Int_t NumObs,
 
 //------------------------------------------------------------------------------
 
-void Blue::SetupRoot(){
+void Blue::SetupRoot() const {
 
-  // Return if not wanted (-1) or done (-2)
+  // Called by the graphics only, such that the solvers do not touch the
+  // global ROOT state. Return if not wanted (-1) or done (-2)
   if(IndRoo < 0)return;
 
   // Setup root
@@ -10364,11 +10948,24 @@ void Blue::SolveScaRho(const Int_t FlaFac, const TMatrixD *const MinFac,
     }
   }
     
+  // Scan by updating the solved combination, see SolveScaRhoInc(). Fall
+  // back to FixInp() and Solve() per step if the input of the steps is not
+  // only the scaled correlations, i.e. for initial factors != 1, relative
+  // uncertainties or futched correlations
+  Int_t IsRela = 0;
+  for(Int_t k = 0; k<InpUnc; k++){
+    if(IsRelValUnc() == 1 && IsRelValUnc(IsWhichUnc(k)) == 1)IsRela = 1;
+  }
+  Int_t IsIncr = 0;
+  if(IFound == 0 && IsRela == 0 && IsFutchCor() == 0){
+    IsIncr = SolveScaRhoInc(FlaFac, MinFac, MaxFac);
+  }
+
   // Perform the loop
   Int_t ka = 0;
   Int_t FaiAct = 0;
   ReleaseInp();  
-  for(Int_t ll = 0; ll<InrFac; ll++){
+  for(Int_t ll = 0; ll<InrFac && IsIncr == 0; ll++){
     //printf("... Blue->SolveScaRho(): \n");
     for(Int_t l = 0; l<InpFac; l++){
       ka = 0;    
@@ -10478,8 +11075,189 @@ void Blue::SolveScaRho(const Int_t FlaFac, const TMatrixD *const MinFac,
 
 //------------------------------------------------------------------------------
 
+Int_t Blue::SolveScaRhoInc(const Int_t FlaFac, const TMatrixD *const MinFac,
+			   const TMatrixD *const MaxFac){
+
+  //----------------------------------------------------------------------------
+  // Fill ValSca and SigSca as the loop in SolveScaRho() does, without calling
+  // FixInp() and Solve() per step. Scaling the correlation of source k for
+  // the pairs of estimates in group l by f changes the covariance by
+  // t*D_kl, with t = f-1 and D_kl the part of the covariance of source k
+  // for these pairs. For each step only the results are calculated
+  //
+  //  CovRes = (UT * V(t)^-1 * U)^-1, Lam = V(t)^-1 * U * CovRes
+  //
+  // FlaFac == 0: Each series (k,l) scans V(t) = V + t*D_kl. With V = UT*U,
+  //              (UT)^-1*D_kl*U^-1 = Q*E*QT, and P = U^-1*Q
+  //              V(t)^-1 = P * (1 + t*E)^-1 * PT
+  //              needs one eigen decomposition per series, and no inversion
+  //              of the covariance per step
+  // FlaFac == 1: Each series (l,ll) adds t_k*D_kl for k = 0,1,... to the
+  //              covariance of the previous step, which is inverted per step
+  //
+  // The series are independent and spread over NumThr threads. A step fails
+  // for the same conditions that are checked by InspectResult().
+  // Returns 1 if the scan is done, 0 if the covariance V of the solved
+  // combination is not positive definite
+  //----------------------------------------------------------------------------
+
+  // Factorise the covariance of the solved combination V = UT*U
+  TMatrixDSym SymV(InpEst);
+  for(Int_t i = 0; i<InpEst; i++){
+    for(Int_t j = 0; j<InpEst; j++)SymV(i,j) = Cov->operator()(i,j);
+  }
+  TDecompChol ChlV(SymV);
+  if(ChlV.Decompose() == kFALSE)return 0;
+  TMatrixD UInv(ChlV.GetU());
+  UInv.InvertFast();
+
+  // The covariance per source, the group per pair of estimates and the
+  // variance of the most precise estimate per observable (or -1 if it is the
+  // only estimate of this observable)
+  std::vector<TMatrixD> CovK(InpUnc, TMatrixD(InpEst,InpEst));
+  for(Int_t k = 0; k<InpUnc; k++)FillCovSource(k, &CovK[k]);
+  std::vector<Int_t> Grp(InpEst*InpEst);
+  for(Int_t i = 0; i<InpEst; i++){
+    for(Int_t j = 0; j<InpEst; j++){
+      Grp[i*InpEst+j] = i == j ? -1 :
+	static_cast<Int_t>(MatFac->operator()(IsWhichEst(i),IsWhichEst(j)));
+    }
+  }
+  std::vector<Double_t> SigPre(InpObs, -1.);
+  for(Int_t n = 0; n<InpObs; n++){
+    Int_t CouEst = 0;
+    for(Int_t i = 0; i<InpEst; i++){
+      if(EstWhichObs(IsWhichEst(i)) == IsWhichObs(n))CouEst = CouEst + 1;
+    }
+    for(Int_t i = 0; i<InpEst && CouEst > 1; i++){
+      if(IsWhichEst(i) == GetPreEst(IsWhichObs(n)))SigPre[n] = Sig->operator()(i);
+    }
+  }
+
+  // The scale factor of source k in group l at step ll
+  auto RhoFac = [&](const Int_t k, const Int_t l, const Int_t ll){
+    const Int_t ko = IsWhichUnc(k);
+    const Double_t Ste = (MaxFac->operator()(ko,l) - MinFac->operator()(ko,l))/InrFac;
+    return MaxFac->operator()(ko,l) - (ll+1)*Ste;
+  };
+
+  // Do the series
+  const Int_t NumSer = FlaFac == 0 ? InpUnc*InpFac : InpFac*InrFac;
+  Int_t NumUse = NumThr;
+  if(NumUse <= 0)NumUse = std::thread::hardware_concurrency();
+  NumUse = TMath::Max(1, TMath::Min(NumUse, NumSer));
+  std::atomic<Int_t> NexSer(0);
+  std::atomic<Int_t> NumFai(0);
+  auto RunSer = [&](){
+    TMatrixD D(InpEst,InpEst), M(InpEst,InpEst), P(InpEst,InpEst);
+    TMatrixD W(InpEst,InpObs), PW(InpEst,InpObs), CovS(InpEst,InpEst);
+    TMatrixD H(InpEst,InpObs), CovResS(InpObs,InpObs), LamS(InpEst,InpObs);
+    TMatrixDSym SymM(InpEst), SymEst(InpEst), SymObs(InpObs);
+    TDecompChol ChlEst(InpEst), ChlObs(InpObs);
+    std::vector<Double_t> T(InpUnc, 0.);
+
+    // Fill D_kl
+    auto FillD = [&](const Int_t k, const Int_t l){
+      for(Int_t i = 0; i<InpEst; i++){
+	for(Int_t j = 0; j<InpEst; j++){
+	  D(i,j) = Grp[i*InpEst+j] == l ? CovK[k](i,j) : 0.;
+	}
+      }
+    };
+
+    // Get the results from H = V(t)^-1 * U, inspect and save them
+    auto SaveRes = [&](const Int_t l, const Int_t Row, const Int_t ll){
+      CovResS.TMult(*Uma, H);
+      CalcInvert(&CovResS, &CovResS, &SymObs, &ChlObs, "SolveScaRhoInc()");
+      LamS.Mult(H, CovResS);
+      Int_t IFail = 0;
+      for(Int_t n = 0; n<InpObs; n++){
+	const Double_t Var = CovResS(n,n);
+	if(Var < 0 || TMath::IsNaN(Var) == 1)IFail = 1;
+	if(SigPre[n] >= 0 && TMath::Sqrt(Var) > SigPre[n])IFail = 1;
+	for(Int_t k = 0; k<InpUnc; k++){
+	  Double_t VarK = 0.;
+	  for(Int_t i = 0; i<InpEst; i++){
+	    for(Int_t j = 0; j<InpEst; j++){
+	      Double_t CovIJ = CovK[k](i,j);
+	      if(Grp[i*InpEst+j] == l)CovIJ = CovIJ*(1. + T[k]);
+	      VarK = VarK + LamS(i,n)*CovIJ*LamS(j,n);
+	    }
+	  }
+	  if(VarK < 0 || TMath::IsNaN(VarK) == 1)IFail = 1;
+	}
+      }
+      for(Int_t n = 0; n<InpObs; n++){
+	if(IFail == 1){
+	  ValSca[n]->operator()(Row,ll) = -1.00;
+	  SigSca[n]->operator()(Row,ll) = -1.00;
+	}else{
+	  Double_t Val = 0.;
+	  for(Int_t i = 0; i<InpEst; i++)Val = Val + LamS(i,n)*Xva->operator()(i);
+	  ValSca[n]->operator()(Row,ll) = Val - XvaRes->operator()(n);
+	  SigSca[n]->operator()(Row,ll) = TMath::Sqrt(CovResS(n,n)) - 
+	    TMath::Sqrt(CovRes->operator()(n,n));
+	}
+      }
+      if(IFail == 1)NumFai += InpObs;
+    };
+
+    for(Int_t S = NexSer++; S<NumSer; S = NexSer++){
+      std::fill(T.begin(), T.end(), 0.);
+      if(FlaFac == 0){
+	// Series (k,l): Diagonalise (UT)^-1 * D_kl * U^-1
+	const Int_t k = S % InpUnc, l = S / InpUnc;
+	FillD(k, l);
+	M.Mult(D, UInv);
+	M.TMult(UInv, TMatrixD(M));
+	for(Int_t i = 0; i<InpEst; i++){
+	  for(Int_t j = 0; j<InpEst; j++)SymM(i,j) = 0.5*(M(i,j) + M(j,i));
+	}
+	TMatrixDSymEigen Eig(SymM);
+	const TVectorD& E = Eig.GetEigenValues();
+	P.Mult(UInv, Eig.GetEigenVectors());
+	W.TMult(P, *Uma);
+	for(Int_t ll = 0; ll<InrFac; ll++){
+	  T[k] = RhoFac(k, l, ll) - 1.;
+	  for(Int_t i = 0; i<InpEst; i++){
+	    for(Int_t n = 0; n<InpObs; n++)PW(i,n) = W(i,n) / (1. + T[k]*E(i));
+	  }
+	  H.Mult(P, PW);
+	  SaveRes(l, k+l*InpUnc, ll);
+	}
+      }else{
+	// Series (l,ll): Add the scaled sources one by one
+	const Int_t l = S % InpFac, ll = S / InpFac;
+	CovS = *Cov;
+	for(Int_t k = 0; k<InpUnc; k++){
+	  T[k] = RhoFac(k, l, ll) - 1.;
+	  FillD(k, l);
+	  CovS.operator+=(T[k]*D);
+	  CalcInvert(&CovS, &M, &SymEst, &ChlEst, "SolveScaRhoInc()");
+	  H.Mult(M, *Uma);
+	  SaveRes(l, k+l*InpUnc, ll);
+	}
+      }
+    }
+  };
+  if(NumUse == 1){
+    RunSer();
+  }else{
+    std::vector<std::thread> Threads;
+    for(Int_t t = 0; t<NumUse; t++)Threads.emplace_back(RunSer);
+    for(auto& Thread : Threads)Thread.join();
+  }
+  FaiFac = FaiFac + NumFai;
+
+  // Return
+  return 1;
+};
+
+//------------------------------------------------------------------------------
+
 void Blue::SetIsSolved(const Int_t l){
   IsSolve = l;
+  IsJacRes = 0;
   if(l == 1 && IsQuiet() == 0){
     printf("... Blue->SetIsSolved(1): Input was solved! \n");
   }
@@ -10609,48 +11387,65 @@ void Blue::SetIsInspectLike(const Int_t l){
 // Filler
 //------------------------------------------------------------------------------
 
-void Blue::FillCov(){
-  // Reset the Covariance Matrix
-  Cov->Delete(); Cov  = new TMatrixD(InpEst,InpEst);
+void Blue::ResizeWork(){
+  // Nothing to do as long as the active inputs keep their number
+  if(WrkEst == InpEst && WrkObs == InpObs)return;
+  WrkEst = InpEst;
+  WrkObs = InpObs;
 
-  TMatrixD *C = new TMatrixD(InpEst,InpEst);
-  TMatrixD *E = new TMatrixD(InpEst,InpEst);
-  TMatrixD *H = new TMatrixD(InpEst,InpEst);
-  TMatrixD *I = new TMatrixD(InpEst,InpEst);
+  // Resize the workspace, see Solve()
+  WrkH->ResizeTo(InpEst,InpObs);
+  WrkI->ResizeTo(InpEst,InpEst);
+  WrkJ->ResizeTo(InpEst,InpObs);
+  WrkK->ResizeTo(InpObs,InpEst);
+  WrkL->ResizeTo(InpObs,InpObs);
+  WrkM->ResizeTo(InpEst,1);
+  WrkN->ResizeTo(InpEst,1);
+  WrkO->ResizeTo(1,InpEst);
+  WrkSym[0]->ResizeTo(InpEst,InpEst);
+  WrkSym[1]->ResizeTo(InpObs,InpObs);
 
-  Int_t IRowLow, IRowHig, IColLow, IColHig;
-  for(Int_t k = 0; k<InpUnc; k++){
-    IRowLow = k*InpEst; 
-    IRowHig = IRowLow + InpEst-1;
-    IColLow = IRowLow;
-    IColHig = IRowHig;
-    //printf("... Blue->FillCov(): %3i, %3i, %3i, %3i \n",IRowLow, IColLow, IRowHig, IColHig);
-
-    // Sigmas per source
-    Unc->GetSub(IRowLow, IRowHig, IColLow, IColHig, *E, "S");
-    //E->Print();
-    
-    // Correlation per source
-    Cor->GetSub(IRowLow, IRowHig, IColLow, IColHig, *C, "S");
-    //C->Print();
+  // Return
+  return;
+};
+
+//------------------------------------------------------------------------------
 
-    // Sum it up = sum E*C*E
-    H->Mult(*E, *C);
-    I->Mult(*H, *E);
-    //I->Print();
+void Blue::FillCov(){
+  // Reset the Covariance Matrix
+  Cov->ResizeTo(InpEst,InpEst);
+  Cov->Zero();
 
-    Cov->operator+=(*I);
+  // Sum it up = sum Sig_k*Cor_k*Sig_k
+  for(Int_t k = 0; k<InpUnc; k++){
+    for(Int_t i = 0; i<InpEst; i++){
+      for(Int_t j = 0; j<InpEst; j++){
+	Cov->operator()(i,j) += Unc->operator()(i,k) *
+	  Cor[k]->operator()(i,j) * Unc->operator()(j,k);
+      }
+    }
     //printf("... Blue->FillCov(): Covariance \n"); Cov->Print();
   }
 
   // Enable to check for positive Eigenvalues
   // ICheck = GetMatEigen(Cov);
 
-  // Clean up and return
-  C->Delete(); C = NULL;
-  E->Delete(); E = NULL;
-  H->Delete(); H = NULL;
-  I->Delete(); I = NULL;
+  // Return
+  return;
+};
+
+//------------------------------------------------------------------------------
+
+void Blue::FillCovSource(const Int_t k, TMatrixD *const CovK) const {
+  // Covariance of source k: CovK(i,j) = Sig(i,k)*Cor_k(i,j)*Sig(j,k)
+  for(Int_t i = 0; i<InpEst; i++){
+    for(Int_t j = 0; j<InpEst; j++){
+      CovK->operator()(i,j) = Unc->operator()(i,k) *
+	Cor[k]->operator()(i,j) * Unc->operator()(j,k);
+    }
+  }
+
+  // Return
   return;
 };
 
@@ -10658,11 +11453,10 @@ void Blue::FillCov(){
 
 void Blue::FillCovInvert(){
   // Reset inverse covariance
-  CovI->Delete(); CovI = new TMatrixD(InpEst,InpEst);
+  CovI->ResizeTo(InpEst,InpEst);
   
-  // Get covarianca and invert
-  CovI->SetSub(0,0,*Cov);
-  CovI->Invert();
+  // Get covariance and invert
+  CalcInvert(Cov, CovI, "FillCovInvert()");
   //printf("... Blue->FillCovInvert(): Inverse covariance \n"); CovI->Print();
 
   // Return
@@ -10671,9 +11465,52 @@ void Blue::FillCovInvert(){
  
 //------------------------------------------------------------------------------
 
+Int_t Blue::FillRelUnc(){
+  // Rescale the relative uncertainties to the present XvaRes as in FixInp()
+  // and refresh the quantities derived from them. The return value is the
+  // number of unphysical uncertainties, in which case nothing is changed
+  Int_t IFail = 0;
+  Double_t ValCom = 0, UncCom = 0;
+  for(Int_t l = 0; l<InpUnc; l++){
+    if(IsRelValUnc(IsWhichUnc(l)) != 1)continue;
+    for(Int_t j = 0; j<InpEst; j++){
+      ValCom = 0.;
+      for(Int_t n = 0; n<InpObs; n++){
+	ValCom = ValCom + Uma->operator()(j,n)*XvaRes->operator()(n);
+      }
+      UncCom = CalcRelUnc(IsWhichEst(j), IsWhichUnc(l), ValCom);
+      if(UncCom < 0)IFail = IFail + 1;
+    }
+  }
+  if(IFail > 0)return IFail;
+
+  // Fill the uncertainties
+  for(Int_t l = 0; l<InpUnc; l++){
+    if(IsRelValUnc(IsWhichUnc(l)) != 1)continue;
+    for(Int_t j = 0; j<InpEst; j++){
+      ValCom = 0.;
+      for(Int_t n = 0; n<InpObs; n++){
+	ValCom = ValCom + Uma->operator()(j,n)*XvaRes->operator()(n);
+      }
+      Unc->operator()(j,l) = CalcRelUnc(IsWhichEst(j), IsWhichUnc(l), ValCom);
+    }
+  }
+
+  // Refresh covariance, uncertainties, inverse and correlations
+  FillCov();
+  FillSig();
+  FillCovInvert();
+  FillRho();
+
+  // Return
+  return 0;
+};
+
+//------------------------------------------------------------------------------
+
 void Blue::FillSig(){
   // Reset the uncertainty vector
-  Sig->Delete(); Sig = new TVectorD(InpEst);
+  Sig->ResizeTo(InpEst);
   for(Int_t i = 0; i<InpEst; i++){
     Sig->operator()(i) = sqrt(Cov->operator()(i,i));
   }
@@ -10690,7 +11527,7 @@ void Blue::FillSig(){
 
 void Blue::FillRho(){
   // Reset the correlation matrix
-  Rho->Delete(); Rho = new TMatrixD(InpEst,InpEst);
+  Rho->ResizeTo(InpEst,InpEst);
   Rho->operator=(*Cov);
   //Rho->Print();
   for(Int_t i = 0; i<InpEst; i++){
@@ -11581,7 +12418,7 @@ void Blue::SetFilledInp(){
     XvaOrig->operator=(*Xva);
     SigOrig->operator=(*Sig);
     UncOrig->operator=(*Unc);
-    CorOrig->operator=(*Cor);
+    for(Int_t k = 0; k<InpUncOrig; k++)CorOrig[k]->operator=(*Cor[k]);
     UmaOrig->operator=(*Uma);
     UtrOrig->operator=(*Utr);
     StaOrig->operator=(*Sta);
@@ -11595,8 +12432,7 @@ void Blue::SetFilledInp(){
     // Much simpler see above
     //Xva->GetSub(0, InpEstOrig-1, *XvaOrig, "S");
     //Sig->GetSub(0, InpEstOrig-1, *SigOrig, "S");
-    //Unc->GetSub(0, InpEstOrig*InpUncOrig-1, 0, InpEstOrig*InpUncOrig-1, *UncOrig, "S");
-    //Cor->GetSub(0, InpEstOrig*InpUncOrig-1, 0, InpEstOrig*InpUncOrig-1, *CorOrig, "S");
+    //Unc->GetSub(0, InpEstOrig-1, 0, InpUncOrig-1, *UncOrig, "S");
     //Uma->GetSub(0, InpEstOrig-1, 0, InpObsOrig-1, *UmaOrig, "S");
     //Utr->GetSub(0, InpObsOrig-1, 0, InpEstOrig-1, *UtrOrig, "S");
 
@@ -11807,7 +12643,7 @@ void Blue::CalcChiRes(const Int_t n, const Int_t IsLike,
 	    if(IsRelValUnc(ko) == 1){
 	      Sigik = CalcRelUnc(io, ko, xi);
 	    }else{
-	      Sigik = Unc->operator()(i+k*InpEst,i+k*InpEst);
+	      Sigik = Unc->operator()(i,k);
 	    }
 	    CO->operator()(i,i) = CO->operator()(i,i) + Sigik * Sigik;
 	  }else{
@@ -11815,10 +12651,10 @@ void Blue::CalcChiRes(const Int_t n, const Int_t IsLike,
 	      Sigik = CalcRelUnc(io, ko, xi);
 	      Sigjk = CalcRelUnc(jo, ko, xj);
 	    }else{
-	      Sigik = Unc->operator()(i+k*InpEst,i+k*InpEst);
-	      Sigjk = Unc->operator()(j+k*InpEst,j+k*InpEst);
+	      Sigik = Unc->operator()(i,k);
+	      Sigjk = Unc->operator()(j,k);
 	    }
-	    Rhova = Cor->operator()(i+k*InpEst,j+k*InpEst);
+	    Rhova = Cor[k]->operator()(i,j);
 	    CO->operator()(i,j) = CO->operator()(i,j) + Rhova * Sigik * Sigjk;
 	  }
 	}
@@ -11831,9 +12667,9 @@ void Blue::CalcChiRes(const Int_t n, const Int_t IsLike,
   }
   //printf("... Blue->CalcChiRes(): CovI, CI \n"); CovI->Print(); CI->Print();
 
-  // Invert the covariance
-  CI->SetSub(0,0,*CO);
-  CI->Invert();
+  // Invert the covariance and get its determinant
+  Double_t DetCO = 0.;
+  CalcInvert(CO, CI, "CalcChiRes()", &DetCO);
   //printf("... Blue->CalcChiRes(): Cov, CO \n");  Cov->Print(); CO->Print();
 
   // Calculate ET * CI * EE 
@@ -11842,7 +12678,7 @@ void Blue::CalcChiRes(const Int_t n, const Int_t IsLike,
 
   // The results
   ChiRes->operator()(0,0) = VA->operator()(0, 0);
-  ChiRes->operator()(1,0) = TMath::Abs(CO->Determinant());
+  ChiRes->operator()(1,0) = TMath::Abs(DetCO);
 
   // Clean up matrices and return
   EE->Delete(); EE = NULL;
@@ -11856,18 +12692,275 @@ void Blue::CalcChiRes(const Int_t n, const Int_t IsLike,
 
 //------------------------------------------------------------------------------
 
+void Blue::CalcLikScan(const Int_t n, const Int_t IsLike,
+		       const Double_t xlow, const Double_t xste,
+		       const Int_t nste, Double_t *const LogLik) const {
+
+  //----------------------------------------------------------------------------
+  // Fill LogLik[s] = -2 ln(Like(x)) for x = xlow + s*xste, s = 0,...,nste,
+  // with Like(x) as in Likelihood(), but without repeating for each x what
+  // does not depend on it. With ei = xi - ui*x and ui = 1/0 for xi
+  // determining Obs == n / m != n:
+  //
+  // -2 ln(Like) = InpEst*ln(2pi) + ln(Abs(Det(V))) + e^T V^-1 e
+  //
+  // For a constant covariance this is a parabola in x, with coefficients
+  // computed from a single inversion. With relative uncertainties V depends
+  // on x, and it is factorised once per step.
+  //----------------------------------------------------------------------------
+
+  // Check if at least one relative uncertainty exist
+  Int_t IsRela = 0;
+  for(Int_t k = 0; k<InpUncOrig; k++)if(IsRelValUnc(k) == 1)IsRela = 1;
+
+  // The parts of ei and the combined value that do not depend on x
+  TVectorD E0(InpEst), U0(InpEst), XCom(InpEst);
+  for(Int_t i = 0; i<InpEst; i++){
+    if(EstWhichObs(IsWhichEst(i)) == n){
+      E0(i) = Xva->operator()(i);
+      U0(i) = 1.;
+    }else{
+      XCom(i) = XvaRes->operator()(IsIndexObs(EstWhichObs(IsWhichEst(i))));
+      E0(i) = Xva->operator()(i) - XCom(i);
+      U0(i) = 0.;
+    }
+  }
+  const Double_t Con = InpEst * TMath::Log(2*TMath::ACos(-1.));
+
+  if(IsLike == 0 || IsRela == 0){
+    // Constant covariance: e^T V^-1 e = a - 2*b*x + c*x^2
+    TMatrixD CI(InpEst,InpEst);
+    Double_t DetCO = 0.;
+    CalcInvert(Cov, &CI, "CalcLikScan()", &DetCO);
+    TVectorD CE = CI * E0, CU = CI * U0;
+    const Double_t a = E0 * CE, b = U0 * CE, c = U0 * CU;
+    const Double_t d = Con + TMath::Log(TMath::Abs(DetCO));
+    for(Int_t s = 0; s<=nste; s++){
+      const Double_t x = xlow + s*xste;
+      LogLik[s] = d + a - 2.*b*x + c*x*x;
+    }
+    return;
+  }
+
+  // Relative uncertainties: Fill the covariance of the absolute uncertainties
+  // once and add the relative ones for each x
+  TMatrixDSym CA(InpEst), CO(InpEst);
+  for(Int_t k = 0; k<InpUnc; k++){
+    if(IsRelValUnc(IsWhichUnc(k)) == 1)continue;
+    for(Int_t i = 0; i<InpEst; i++){
+      CA(i,i) += Unc->operator()(i,k) * Unc->operator()(i,k);
+      for(Int_t j = i+1; j<InpEst; j++){
+	CA(i,j) += Cor[k]->operator()(i,j) * Unc->operator()(i,k) * Unc->operator()(j,k);
+	CA(j,i) = CA(i,j);
+      }
+    }
+  }
+  TMatrixD SR(InpEst,InpUnc);
+  TDecompChol Chl(InpEst);
+  TVectorD EE(InpEst), DU(InpEst);
+  Double_t xi = 0, d1 = 0, d2 = 0;
+  for(Int_t s = 0; s<=nste; s++){
+    const Double_t x = xlow + s*xste;
+
+    // The relative uncertainties at x
+    for(Int_t k = 0; k<InpUnc; k++){
+      const Int_t ko = IsWhichUnc(k);
+      if(IsRelValUnc(ko) == 0)continue;
+      for(Int_t i = 0; i<InpEst; i++){
+	xi = U0(i) == 1. ? x : XCom(i);
+	SR(i,k) = CalcRelUnc(IsWhichEst(i), ko, xi);
+      }
+    }
+    CO = CA;
+    for(Int_t k = 0; k<InpUnc; k++){
+      if(IsRelValUnc(IsWhichUnc(k)) == 0)continue;
+      for(Int_t i = 0; i<InpEst; i++){
+	CO(i,i) += SR(i,k) * SR(i,k);
+	for(Int_t j = i+1; j<InpEst; j++){
+	  CO(i,j) += Cor[k]->operator()(i,j) * SR(i,k) * SR(j,k);
+	  CO(j,i) = CO(i,j);
+	}
+      }
+    }
+
+    // Factorise V = UT*U, which gives V^-1 e and Det(V) at once
+    for(Int_t i = 0; i<InpEst; i++)EE(i) = E0(i) - U0(i)*x;
+    Chl.SetMatrix(CO);
+    if(Chl.Decompose()){
+      DU = EE;
+      Chl.Solve(DU);
+      Chl.Det(d1, d2);
+      LogLik[s] = Con + TMath::Log(d1) + d2*TMath::Log(2.) + EE * DU;
+    }else{
+      // Fall back to the general inversion
+      CalcChiRes(n, IsLike, x);
+      LogLik[s] = Con + TMath::Log(ChiRes->operator()(1,0)) + ChiRes->operator()(0,0);
+    }
+  }
+  return;
+};
+
+//------------------------------------------------------------------------------
+
+Int_t Blue::CalcLikInt(const Double_t *const LogLik, const Int_t nste,
+		       const Double_t xlow, const Double_t xste,
+		       Double_t *const xmax, Double_t *const LogMin,
+		       Double_t *const xdow, Double_t *const xupp) const {
+
+  // Get the maximum of the likelihood from the grid LogLik = -2 ln(Like),
+  // see CalcLikScan(), and the x values where LogLik is larger by one.
+  // Return 0 if both are found, +1/+2 if the lower/upper is not found
+  // within the grid, in which case it is set to the grid limit
+  Int_t IFail = 0;
+
+  // Find the smallest value and refine it by a parabola through the
+  // neighbours
+  Int_t smin = 0;
+  for(Int_t s = 1; s<=nste; s++)if(LogLik[s] < LogLik[smin])smin = s;
+  *xmax   = xlow + smin*xste;
+  *LogMin = LogLik[smin];
+  if(smin > 0 && smin < nste){
+    const Double_t dl = LogLik[smin+1] - LogLik[smin-1];
+    const Double_t cu = LogLik[smin+1] - 2.*LogLik[smin] + LogLik[smin-1];
+    if(cu > 0){
+      *xmax   = *xmax - 0.5*xste*dl/cu;
+      *LogMin = *LogMin - 0.125*dl*dl/cu;
+    }
+  }
+
+  // Interpolate linearly where the grid crosses LogMin + 1
+  const Double_t LogOne = *LogMin + 1;
+  *xdow = xlow;
+  IFail = IFail + 1;
+  for(Int_t s = smin-1; s>=0; s--){
+    if(LogLik[s] > LogOne){
+      *xdow = xlow + (s + (LogLik[s]-LogOne)/(LogLik[s]-LogLik[s+1]))*xste;
+      *xdow = TMath::Min(*xdow, *xmax);
+      IFail = IFail - 1;
+      break;
+    }
+  }
+  *xupp = xlow + nste*xste;
+  IFail = IFail + 2;
+  for(Int_t s = smin+1; s<=nste; s++){
+    if(LogLik[s] > LogOne){
+      *xupp = xlow + (s - (LogLik[s]-LogOne)/(LogLik[s]-LogLik[s-1]))*xste;
+      *xupp = TMath::Max(*xupp, *xmax);
+      IFail = IFail - 2;
+      break;
+    }
+  }
+  return IFail;
+};
+
+//------------------------------------------------------------------------------
+
+void Blue::CalcJacobian() const {
+
+  //----------------------------------------------------------------------------
+  // Fill the derivatives of the results XvaRes (InpObs) and of their
+  // covariance CovRes (InpObs*InpObs, element n*InpObs+m) with respect to
+  // 1) the correlations of the sources k, shifting all off-diagonal elements
+  //    of Cor[k] together (InpUnc columns), and
+  // 2) the uncertainties Unc(i,k) (InpEst*InpUnc columns, i*InpUnc+k),
+  //    keeping relative uncertainties fixed at their present value.
+  // For a change dV of the covariance, with Lam = V^-1*U*CovRes and
+  // q = V^-1*(x - U*XvaRes) from the solved combination
+  //
+  //  d(CovRes) =  LamT * dV * Lam
+  //  d(XvaRes) = -LamT * dV * q
+  //
+  // For 1) dV(i,j) = Unc(i,k)*Unc(j,k) for i != j, for 2) dV = ei*vT + v*eiT
+  // with v(j) = Cor[k](i,j)*Unc(j,k).
+  // Both are filled in JacValRes and JacCovRes at once, and only if they
+  // are not already filled for the present solution (IsJacRes).
+  //----------------------------------------------------------------------------
+
+  if(IsJacRes == 1)return;
+  JacValRes->ResizeTo(InpObs,InpUnc+InpEst*InpUnc);
+  JacCovRes->ResizeTo(InpObs*InpObs,InpUnc+InpEst*InpUnc);
+  TMatrixD* JacVal = JacValRes;
+  TMatrixD* JacCov = JacCovRes;
+
+  // The weighted residuals q
+  TVectorD Res(InpEst);
+  for(Int_t i = 0; i<InpEst; i++){
+    Res(i) = Xva->operator()(i);
+    for(Int_t n = 0; n<InpObs; n++){
+      Res(i) = Res(i) - Uma->operator()(i,n)*XvaRes->operator()(n);
+    }
+  }
+  TVectorD Q = (*CovI) * Res;
+
+  // 1) The correlations
+  TMatrixD D(InpEst,InpEst), DL(InpEst,InpObs);
+  TVectorD DQ(InpEst);
+  Double_t Sum = 0;
+  for(Int_t k = 0; k<InpUnc; k++){
+    for(Int_t i = 0; i<InpEst; i++){
+      for(Int_t j = 0; j<InpEst; j++){
+	D(i,j) = i == j ? 0. : Unc->operator()(i,k)*Unc->operator()(j,k);
+      }
+    }
+    DL.Mult(D, *Lam);
+    DQ = D * Q;
+    for(Int_t n = 0; n<InpObs; n++){
+      Sum = 0;
+      for(Int_t i = 0; i<InpEst; i++)Sum = Sum + Lam->operator()(i,n)*DQ(i);
+      JacVal->operator()(n,k) = -Sum;
+      for(Int_t m = 0; m<InpObs; m++){
+	Sum = 0;
+	for(Int_t i = 0; i<InpEst; i++)Sum = Sum + Lam->operator()(i,n)*DL(i,m);
+	JacCov->operator()(n*InpObs+m,k) = Sum;
+      }
+    }
+  }
+
+  // 2) The uncertainties
+  TVectorD V(InpEst), A(InpObs);
+  Double_t VQ = 0;
+  Int_t p = 0;
+  for(Int_t i = 0; i<InpEst; i++){
+    for(Int_t k = 0; k<InpUnc; k++){
+      p = InpUnc + i*InpUnc + k;
+      VQ = 0;
+      for(Int_t j = 0; j<InpEst; j++){
+	V(j) = Cor[k]->operator()(i,j)*Unc->operator()(j,k);
+	VQ = VQ + V(j)*Q(j);
+      }
+      for(Int_t n = 0; n<InpObs; n++){
+	A(n) = 0;
+	for(Int_t j = 0; j<InpEst; j++)A(n) = A(n) + Lam->operator()(j,n)*V(j);
+      }
+      for(Int_t n = 0; n<InpObs; n++){
+	JacVal->operator()(n,p) = -(Lam->operator()(i,n)*VQ + A(n)*Q(i));
+	for(Int_t m = 0; m<InpObs; m++){
+	  JacCov->operator()(n*InpObs+m,p) =
+	    Lam->operator()(i,n)*A(m) + A(n)*Lam->operator()(i,m);
+	}
+      }
+    }
+  }
+  IsJacRes = 1;
+
+  // Return
+  return;
+};
+
+//------------------------------------------------------------------------------
+
 void Blue::CalcParams(){
   //printf("... Blue->CalcParams(): Rho \n"); Rho->Print()
   //printf("... Blue->CalcParams(): Sig \n"); Sig->Print();
   
   // Reset matrices
-  SRat->Delete(); SRat = new TMatrixD(InpEstOrig,InpEstOrig);
-  Beta->Delete(); Beta = new TMatrixD(InpEstOrig,InpEstOrig);
-  Sigx->Delete(); Sigx = new TMatrixD(InpEstOrig,InpEstOrig);
-  DBdr->Delete(); DBdr = new TMatrixD(InpEstOrig,InpEstOrig);
-  DSdr->Delete(); DSdr = new TMatrixD(InpEstOrig,InpEstOrig);
-  DBdz->Delete(); DBdz = new TMatrixD(InpEstOrig,InpEstOrig);
-  DSdz->Delete(); DSdz = new TMatrixD(InpEstOrig,InpEstOrig);
+  SRat->Zero();
+  Beta->Zero();
+  Sigx->Zero();
+  DBdr->Zero();
+  DSdr->Zero();
+  DBdz->Zero();
+  DSdz->Zero();
   
   // Loop and fill lower half
   Double_t rho = 0, zva = 0;
@@ -11947,6 +13040,181 @@ Double_t Blue::CalcFutchCor(const Int_t i, const Int_t j){
 
 //------------------------------------------------------------------------------
 
+Int_t Blue::CalcInvert(const TMatrixD *const InpMat, TMatrixD *const OutMat,
+		       const TString Caller, Double_t *const Det) const {
+
+  // Use the workspace for the estimates or the observables
+  Int_t NRows = InpMat->GetNrows();
+  Int_t IWrk = 0;
+  if(NRows != WrkSym[0]->GetNrows()){
+    IWrk = 1;
+    if(NRows != WrkSym[1]->GetNrows())WrkSym[1]->ResizeTo(NRows,NRows);
+  }
+  return CalcInvert(InpMat, OutMat, WrkSym[IWrk], WrkChl[IWrk], Caller, Det);
+};
+
+//------------------------------------------------------------------------------
+
+Int_t Blue::CalcInvert(const TMatrixD *const InpMat, TMatrixD *const OutMat,
+		       TMatrixDSym *const SymMat, TDecompChol *const Chol,
+		       const TString Caller, Double_t *const Det) const {
+
+  // The return value  1 / 0 = positive definite / not positive definite
+  Int_t IPosi = 1;
+
+  // The covariances are symmetric and positive definite by construction, so
+  // invert them via Cholesky InpMat = UT*U and triangular solves for U.
+  // Only the workspace SymMat and Chol is changed, which must have the
+  // dimension of InpMat
+  Int_t NRows = InpMat->GetNrows();
+  for(Int_t i = 0; i<NRows; i++){
+    for(Int_t j = 0; j<NRows; j++){
+      SymMat->operator()(i,j) = 0.5 * (InpMat->operator()(i,j) +
+				       InpMat->operator()(j,i));
+    }
+  }
+  Chol->SetMatrix(*SymMat);
+  if(Chol->Decompose()){
+    Double_t d1 = 0., d2 = 0.;
+    Chol->Invert(*SymMat);
+    OutMat->SetSub(0,0,*SymMat);
+    Chol->Det(d1, d2);
+    if(Det != NULL)*Det = d1 * TMath::Power(2., d2);
+  }else{
+    // Report and fall back to the general inversion. CalcChiRes inverts for
+    // every point of the likelihood, so only report with a print level
+    IPosi = 0;
+    if(IsQuiet() == 0 && IsPrintLevel() >= 1){
+      printf("... Blue->%s: The covariance matrix is not", Caller.Data());
+      printf(" positive definite, CHECK INPUT \n");
+      if(IsPrintLevel() >= 2)InpMat->Print();
+    }
+    OutMat->SetSub(0,0,*InpMat);
+    OutMat->Invert(Det);
+  }
+
+  // Return
+  return IPosi;
+};
+
+//------------------------------------------------------------------------------
+
+Int_t Blue::CalcInvDel(TMatrixD *const InvMat, Int_t *const Act,
+		       const Int_t j, TMatrixD *const WrkVec) const {
+
+  // The return value  1 / 0 = updated / pivot not positive
+  // InvMat is the inverse covariance of the estimates with Act(i) == 1, with
+  // zero rows and columns for the others. Remove estimate j, i.e. take the
+  // Schur complement: InvMat(a,b) -= InvMat(a,j)*InvMat(j,b)/InvMat(j,j)
+  Act[j] = 0;
+  Double_t Piv = InvMat->operator()(j,j);
+  if(Piv <= 0)return 0;
+  for(Int_t a = 0; a<InpEst; a++){
+    WrkVec->operator()(a,0) = InvMat->operator()(a,j);
+  }
+  for(Int_t a = 0; a<InpEst; a++){
+    if(Act[a] == 0)continue;
+    for(Int_t b = 0; b<InpEst; b++){
+      if(Act[b] == 0)continue;
+      InvMat->operator()(a,b) -= 
+	WrkVec->operator()(a,0) * WrkVec->operator()(b,0) / Piv;
+    }
+  }
+  for(Int_t a = 0; a<InpEst; a++){
+    InvMat->operator()(a,j) = 0.;
+    InvMat->operator()(j,a) = 0.;
+  }
+
+  // Return
+  return 1;
+};
+
+//------------------------------------------------------------------------------
+
+Int_t Blue::CalcInvAdd(TMatrixD *const InvMat, Int_t *const Act,
+		       const Int_t j, TMatrixD *const WrkVec) const {
+
+  // The return value  1 / 0 = updated / pivot not positive
+  // Add estimate j by bordering: with c = Cov(.,j), w = InvMat*c and
+  // s = Cov(j,j) - cT*w the new inverse is
+  // InvMat + w*wT/s, -w/s in row and column j, and 1/s at (j,j)
+  Act[j] = 1;
+  Double_t s = Cov->operator()(j,j);
+  for(Int_t a = 0; a<InpEst; a++){
+    WrkVec->operator()(a,0) = 0.;
+    if(Act[a] == 0 || a == j)continue;
+    for(Int_t b = 0; b<InpEst; b++){
+      if(Act[b] == 0 || b == j)continue;
+      WrkVec->operator()(a,0) += InvMat->operator()(a,b)*Cov->operator()(b,j);
+    }
+    s = s - Cov->operator()(j,a)*WrkVec->operator()(a,0);
+  }
+  if(s <= 0)return 0;
+  for(Int_t a = 0; a<InpEst; a++){
+    if(Act[a] == 0 || a == j)continue;
+    for(Int_t b = 0; b<InpEst; b++){
+      if(Act[b] == 0 || b == j)continue;
+      InvMat->operator()(a,b) += 
+	WrkVec->operator()(a,0) * WrkVec->operator()(b,0) / s;
+    }
+    InvMat->operator()(a,j) = -WrkVec->operator()(a,0) / s;
+    InvMat->operator()(j,a) = -WrkVec->operator()(a,0) / s;
+  }
+  InvMat->operator()(j,j) = 1. / s;
+
+  // Return
+  return 1;
+};
+
+//------------------------------------------------------------------------------
+
+void Blue::CalcInvAct(TMatrixD *const InvMat, const Int_t *const Act) const {
+
+  // Fall back for the rank-one updates: invert the covariance of the 
+  // estimates with Act(i) == 1, with unit diagonal for the others, and
+  // clear the rows and columns of the others
+  TMatrixD* ActCov = new TMatrixD(InpEst,InpEst);
+  for(Int_t a = 0; a<InpEst; a++){
+    for(Int_t b = 0; b<InpEst; b++){
+      if(Act[a] == 1 && Act[b] == 1){
+	ActCov->operator()(a,b) = Cov->operator()(a,b);
+      }else if(a == b){
+	ActCov->operator()(a,b) = 1.;
+      }
+    }
+  }
+  CalcInvert(ActCov, InvMat, "CalcInvAct()");
+  for(Int_t a = 0; a<InpEst; a++){
+    if(Act[a] == 1)continue;
+    for(Int_t b = 0; b<InpEst; b++){
+      InvMat->operator()(a,b) = 0.;
+      InvMat->operator()(b,a) = 0.;
+    }
+  }
+  ActCov->Delete(); ActCov = NULL;
+
+  // Return
+  return;
+};
+
+//------------------------------------------------------------------------------
+
+void Blue::CalcSolveInv(const TMatrixD *const InvMat, TMatrixD *const HMat,
+			TMatrixD *const CovMat, TMatrixD *const LamMat) const {
+
+  // The combination for the inverse covariance InvMat, see Solve(). Inactive
+  // estimates have zero rows in InvMat and hence get zero weights
+  HMat->Mult(*InvMat, *Uma);
+  CovMat->Mult(*Utr, *HMat);
+  CalcInvert(CovMat, CovMat, "CalcSolveInv()");
+  LamMat->Mult(*HMat, *CovMat);
+
+  // Return
+  return;
+};
+
+//------------------------------------------------------------------------------
+
 Double_t Blue::CalcUncDif(const    Int_t ic, const Double_t rh,
 			  const Double_t u1, const Double_t s1,
 			  const Double_t u2, const Double_t s2) const {
@@ -12186,7 +13454,7 @@ void Blue::WriteInput(const Int_t IWhat, const TString FilNam,
       IRet = sprintf(c,Format,Sig->operator()(i)); ofs<<c;
     }else{
       for(Int_t k = 0; k < InpUnc; k++){
-	IRet = sprintf(c,Format,Unc->operator()(i+k*InpEst,i+k*InpEst)); ofs<<c;
+	IRet = sprintf(c,Format,Unc->operator()(i,k)); ofs<<c;
       }
     }
     IRet = sprintf(c,"\n"); ofs<<c;
@@ -12205,26 +13473,15 @@ void Blue::WriteInput(const Int_t IWhat, const TString FilNam,
     }
   }else{
     for(Int_t k = 0; k < InpUnc; k++){
-      // Get the matrix per source
-      TMatrixD *F = new TMatrixD(InpEst,InpEst);
-      Int_t IRowLow = k*InpEst; 
-      Int_t IRowHig = IRowLow + InpEst-1;
-      Int_t IColLow = IRowLow; 
-      Int_t IColHig = IRowHig;
-      //  printf("... %3i, %3i, %3i, %3i \n",IRowLow, IColLow, IRowHig, IColHig);
-      Cor->GetSub(IRowLow, IRowHig, IColLow, IColHig, *F, "S");
-
-      // Write the findings
+      // Write the matrix per source
       for(Int_t i = 0; i < InpEst; i++){
 	for(Int_t j = 0; j < InpEst; j++){
-	  IRet = sprintf(c,Format,F->operator()(i,j)); ofs<<c;
+	  IRet = sprintf(c,Format,Cor[k]->operator()(i,j)); ofs<<c;
 	}
 	if(i == 0){IRet = sprintf(c," '%s'",UncNam[IsWhichUnc(k)].Data()); ofs<<c;};
 	IRet = sprintf(c,"\n"); ofs<<c;
       }
       IRet = sprintf(c,"\n"); ofs<<c;	
-      // clean up
-      F->Delete(); F = NULL;
     }
   }
   
@@ -12241,28 +13498,46 @@ void Blue::WriteInput(const Int_t IWhat, const TString FilNam,
 
 void Blue::SimulInit(const Int_t IniSee) {
 
-  // Set up of random number generator
+  // Set up of the seed of the random number generators
   Int_t ISeed = 123456;
 
   // Add Warning
-  printf("... Blue->SimulInit(): !! Random number generator was changed !!\n");
-  printf("... Blue->SimulInit(): !! from GSLRandomEngine to %s !! \n",
-	 gRandom->GetName());
-  printf("... Blue->SimulInit(): Expect small changes when using");
-  printf(" SolveScaSta(). \n");
+  if(IsQuiet() == 0){
+    printf("... Blue->SimulInit(): !! Random number generator was changed !!\n");
+    printf("... Blue->SimulInit(): !! from gRandom to one TRandom3 per");
+    printf(" simulation !! \n");
+    printf("... Blue->SimulInit(): Expect small changes when using");
+    printf(" SolveScaSta(). \n");
+  }
 
   // Perform initialisation
   if(IniSee > 0)ISeed = IniSee;
-  gRandom->SetSeed(ISeed);
-  printf("... Blue->SimulInit(): %s == %s \n",
-	 gRandom->GetTitle(), gRandom->GetName());
-  printf("... Blue->SimulInit(): is initialised with Seed = %2i \n", ISeed);
+  SimSee = ISeed;
+  if(IsQuiet() == 0){
+    printf("... Blue->SimulInit(): is initialised with Seed = %2i \n", ISeed);
+  }
 
   // Set the flag and return
   IsSeeded = 1;
   return;
 };
 
+//------------------------------------------------------------------------------
+
+UInt_t Blue::SimulSeed(const Int_t N) const {
+  // Seed of the random number generator of simulation N. Mix SimSee and N
+  // (splitmix64) such that the streams of close seeds are unrelated
+  ULong64_t z = static_cast<ULong64_t>(SimSee) * 0x9E3779B97F4A7C15ULL + N;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+
+  // TRandom3 uses a time dependent seed for zero
+  UInt_t ISeed = static_cast<UInt_t>(z & 0xFFFFFFFFULL);
+  if(ISeed == 0)ISeed = 1;
+  return ISeed;
+};
+
 //----------------------------------------------------------------------------
 // Display
 //----------------------------------------------------------------------------
@@ -2,11 +2,15 @@
 #include <BLUE/Utils.h>
 
 #include <TMatrixD.h>
+#include <TMatrixDSym.h>
 #include <TString.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
+#include <filesystem>
 #include <format>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
@@ -27,9 +31,8 @@ namespace {
   void print_help(const BLUE::Combinations& combinations) {
     std::cout << "Available combinations:\n\n";
     for (const auto& [flag, combination] : combinations) {
-      const auto& [title, inputs] = combination;
-      std::cout << std::format("  {:4d}: {}\n", flag, title);
-      for (const auto input : inputs) std::cout << std::format("        - {}\n", input);
+      std::cout << std::format("  {:4d}: {}\n", flag, combination.title);
+      for (const auto input : combination.inputs) std::cout << std::format("        - {}\n", input);
       std::cout << "\n";
     }
   }
@@ -46,11 +49,10 @@ namespace {
   /// Check that every estimate name referenced by `combinations` exists in `index`.
   void validate(const BLUE::Combinations& combinations, const std::map<std::string, int>& index) {
     for (const auto& [flag, combination] : combinations) {
-      const auto& [title, inputs] = combination;
-      for (const auto& input : inputs)
+      for (const auto& input : combination.inputs)
         if (!index.count(input))
-          throw std::runtime_error(
-              std::format("Combination {} ('{}') references unknown estimate '{}'", flag, title, input));
+          throw std::runtime_error(std::format("Combination {} ('{}') references unknown estimate '{}'", flag,
+                                               combination.title, input));
     }
   }
 
@@ -62,29 +64,219 @@ namespace {
               << std::string(line_length, '-') << std::endl;
   }
 
+  /**
+   * Fill a combiner with all estimates, set active. With `multi_obs`, each estimate measures the observable
+   * `Estimate::obs`, otherwise all estimates measure the first one.
+   */
+  std::unique_ptr<Blue> make_blue(const BLUE::Estimates& estimates, const std::vector<TString>& names_obs,
+                                  const std::vector<TString>& names_unc, const std::vector<double>& rho,
+                                  const bool multi_obs) {
+    const auto num_est = estimates.size();
+    const auto num_unc = names_unc.size();
+    const auto num_obs = names_obs.size();
+
+    // Transform the input estimate values into the TMatrixD format expected by the BLUE class
+    std::vector<double> x_est;
+    for (const auto& e : estimates) {
+      if (e.vals.size() != num_unc + 1)
+        throw std::runtime_error("Estimate '" + std::string(e.name) + "' has " + std::to_string(e.vals.size()) +
+                                 " values, expected " + std::to_string(num_unc + 1));
+      if (e.obs < 0 || e.obs >= static_cast<int>(num_obs))
+        throw std::runtime_error("Estimate '" + std::string(e.name) + "' measures observable " +
+                                 std::to_string(e.obs) + ", but only " + std::to_string(num_obs) + " are named");
+      x_est.insert(x_est.end(), e.vals.begin(), e.vals.end());
+    }
+    if (rho.size() != num_unc)
+      throw std::runtime_error("The size of the correlation vector is inconsistent with the number of uncertainties");
+
+    const TMatrixD inp_est(num_est, num_unc + 1, &x_est[0]);
+
+    // Statistical precision in systematic uncertainties
+    const std::vector<double> s_unc(num_est * num_unc, 0.0);
+    const TMatrixD inp_sta(num_est, num_unc, &s_unc[0]);
+
+    std::vector<int> int_obs(num_est, 0);
+    if (multi_obs)
+      for (size_t i = 0; i < num_est; ++i) int_obs[i] = estimates[i].obs;
+    const auto names = get_names(estimates);
+
+    auto blue = std::make_unique<Blue>(num_est, num_unc, multi_obs ? num_obs : 1, &int_obs[0]);
+    blue->FillNamEst(&names[0]);
+    blue->FillNamUnc(&names_unc[0]);
+    blue->FillNamObs(&names_obs[0]);
+    blue->FillEst(&inp_est);
+    blue->FillSta(&inp_sta);
+    for (size_t k = 0; k < num_unc; ++k) blue->FillCor(k, rho[k]);
+    return blue;
+  }
+
+  /// Indices of the estimates of a combination, in the order of the estimates (as they are listed by BLUE).
+  std::vector<int> active_estimates(const BLUE::Combination& combination, const std::map<std::string, int>& index) {
+    std::vector<int> active;
+    for (const auto& input : combination.inputs) active.push_back(index.at(input));
+    std::ranges::sort(active);
+    return active;
+  }
+
+  /// Indices of the observables measured by the estimates `active` of a combination, in the order of `names_obs`.
+  std::vector<int> active_observables(const BLUE::Combination& combination, const BLUE::Estimates& estimates,
+                                      const std::vector<int>& active) {
+    if (!combination.multi_obs) return {0};
+    std::vector<int> active_obs;
+    for (const auto i : active) active_obs.push_back(estimates[i].obs);
+    std::ranges::sort(active_obs);
+    active_obs.erase(std::unique(active_obs.begin(), active_obs.end()), active_obs.end());
+    return active_obs;
+  }
+
+  /// Result of one combination, as written to the JSON output.
+  struct Result {
+    int flag;
+    std::string title;
+    std::vector<std::string> estimates;
+    std::vector<std::string> observables;
+    std::vector<double> values;
+    std::vector<double> uncertainty;
+    std::vector<std::vector<double>> uncertainties;  ///< One row per observable, one column per source.
+    std::vector<std::vector<double>> weights;        ///< One row per estimate, one column per observable.
+    std::vector<std::vector<double>> correlation;
+    std::vector<std::vector<double>> value_drho;        ///< One row per observable, one column per source.
+    std::vector<std::vector<double>> uncertainty_drho;  ///< One row per observable, one column per source.
+    double chi2;
+    int ndof;
+    double prob;
+  };
+
+  // JSON writers for the results. The charm fitter has the same ones in IoUtils.h, which BLUE does not depend on.
+  std::string json_string(const std::string& str) {
+    std::string escaped = "\"";
+    for (const auto c : str) {
+      if (c == '"' || c == '\\') escaped += '\\';
+      escaped += c;
+    }
+    return escaped + "\"";
+  }
+
+  /// Shortest representation that reads back to the same double, or null if it is not finite.
+  std::string json_number(const double val) { return std::isfinite(val) ? std::format("{}", val) : "null"; }
+
+  template <typename T, typename F>
+  std::string json_list(const std::vector<T>& items, F&& to_json) {
+    std::string list = "[";
+    for (const auto& item : items) list += (list.size() > 1 ? ", " : "") + to_json(item);
+    return list + "]";
+  }
+
+  std::string json_matrix(const std::vector<std::vector<double>>& rows) {
+    return json_list(rows, [](const std::vector<double>& row) { return json_list(row, json_number); });
+  }
+
+  std::string trim(const std::string& str) {
+    const auto first = str.find_first_not_of(' ');
+    if (first == std::string::npos) return "";
+    return str.substr(first, str.find_last_not_of(' ') - first + 1);
+  }
+
+  void write_results(const std::filesystem::path& output, const std::string& combo_category,
+                     const std::vector<TString>& names_unc, const std::vector<Result>& results) {
+    const auto to_string = [](const TString& str) { return json_string(trim(str.Data())); };
+    if (output.has_parent_path()) std::filesystem::create_directories(output.parent_path());
+    std::ofstream out(output);
+    out << "{\n"
+        << "  \"category\": " << json_string(combo_category) << ",\n"
+        << "  \"uncertainties\": " << json_list(names_unc, to_string) << ",\n"
+        << "  \"combinations\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+      const auto& r = results[i];
+      out << (i > 0 ? "," : "") << "\n    {\n"
+          << "      \"flag\": " << r.flag << ",\n"
+          << "      \"title\": " << json_string(r.title) << ",\n"
+          << "      \"estimates\": " << json_list(r.estimates, json_string) << ",\n"
+          << "      \"observables\": " << json_list(r.observables, json_string) << ",\n"
+          << "      \"values\": " << json_list(r.values, json_number) << ",\n"
+          << "      \"uncertainty\": " << json_list(r.uncertainty, json_number) << ",\n"
+          << "      \"uncertainties\": " << json_matrix(r.uncertainties) << ",\n"
+          << "      \"weights\": " << json_matrix(r.weights) << ",\n"
+          << "      \"correlation\": " << json_matrix(r.correlation) << ",\n"
+          << "      \"value_drho\": " << json_matrix(r.value_drho) << ",\n"
+          << "      \"uncertainty_drho\": " << json_matrix(r.uncertainty_drho) << ",\n"
+          << "      \"chi2\": " << json_number(r.chi2) << ",\n"
+          << "      \"ndof\": " << r.ndof << ",\n"
+          << "      \"prob\": " << json_number(r.prob) << "\n"
+          << "    }";
+    }
+    out << "\n  ]\n}\n";
+    if (!out) throw std::runtime_error("Cannot write the results to '" + output.string() + "'");
+  }
+
 }  // namespace
 
 namespace BLUE {
 
-  int parse_args(const int argc, char** argv, const Combinations& combinations) {
-    if (argc != 2) {
-      std::cerr << std::format("Usage: {0} <n-combination>\n"
-                               "       {0} --help\n",
-                               argv[0]);
-      std::exit(EXIT_FAILURE);
+  Options parse_args(const int argc, char** argv, const Combinations& combinations) {
+    const auto usage = std::format(
+        "Usage: {0} <n-combination> [<n-combination> ...] [--output <file.json>] [--jacobian]\n"
+        "       {0} --all [--output <file.json>] [--jacobian]\n"
+        "       {0} --help\n",
+        argv[0]);
+    Options options;
+    bool all = false;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "-h" || arg == "--help") {
+        std::cerr << "\n" << usage << "\n";
+        print_help(combinations);
+        std::exit(EXIT_SUCCESS);
+      } else if (arg == "--all") {
+        all = true;
+      } else if (arg == "--output" && i + 1 < argc) {
+        options.output = argv[++i];
+      } else if (arg == "--jacobian") {
+        options.jacobian = true;
+      } else {
+        char* end = nullptr;
+        const auto flag = static_cast<int>(std::strtol(argv[i], &end, 10));
+        if (end == argv[i] || *end != '\0') {
+          std::cerr << usage;
+          std::exit(EXIT_FAILURE);
+        }
+        if (!combinations.count(flag)) {
+          std::cerr << std::format("Unknown combination {}, run {} --help for the available ones\n", flag, argv[0]);
+          std::exit(EXIT_FAILURE);
+        }
+        options.flags.push_back(flag);
+      }
     }
-    if (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help") {
-      std::cerr << std::format("\nUsage: {} <n-combination>\n\n", argv[0]);
-      print_help(combinations);
-      std::exit(EXIT_SUCCESS);
+    if (all == !options.flags.empty()) {
+      std::cerr << usage;
+      std::exit(EXIT_FAILURE);
     }
-    return std::atoi(argv[1]);
+    if (all)
+      for (const auto& [flag, combination] : combinations) options.flags.push_back(flag);
+    return options;
   }
 
   void run_combination(const int flag, const std::string& combo_category, const Combinations& combinations,
                        const Estimates& estimates, const std::vector<TString>& names_obs,
                        const std::vector<TString>& names_unc, const std::vector<double>& rho,
                        const OutputFormat& format) {
+    run_combination(std::vector<int>{flag}, combo_category, combinations, estimates, names_obs, names_unc, rho,
+                    format);
+  }
+
+  void run_combination(const Options& options, const std::string& combo_category, const Combinations& combinations,
+                       const Estimates& estimates, const std::vector<TString>& names_obs,
+                       const std::vector<TString>& names_unc, const std::vector<double>& rho,
+                       const OutputFormat& format) {
+    run_combination(options.flags, combo_category, combinations, estimates, names_obs, names_unc, rho, format,
+                    options.output, options.jacobian);
+  }
+
+  void run_combination(const std::vector<int>& flags, const std::string& combo_category,
+                       const Combinations& combinations, const Estimates& estimates,
+                       const std::vector<TString>& names_obs, const std::vector<TString>& names_unc,
+                       const std::vector<double>& rho, const OutputFormat& format,
+                       const std::filesystem::path& output, const bool print_jacobian) {
 
     const auto num_est = estimates.size();
     const auto num_unc = names_unc.size();
@@ -94,50 +286,118 @@ namespace BLUE {
     const auto index = index_estimates(estimates);
     validate(combinations, index);
 
-    const auto names = get_names(estimates);
+    // Initialise the combiners, which are filled once and shared by all combinations: one where all estimates
+    // measure the first observable, and one where they measure `Estimate::obs`, created when first needed
+    const auto init_blue = [&](const bool multi_obs) {
+      auto blue = make_blue(estimates, names_obs, names_unc, rho, multi_obs);
+      blue->SetFormat(format.for_val, format.for_unc, format.for_wei, format.for_rho, format.for_pul, format.for_chi,
+                      format.for_uni);
+      return blue;
+    };
+    std::unique_ptr<Blue> blue_1d;
+    std::unique_ptr<Blue> blue_multi;
 
-    // Transform the input estimate values into the TMatrixD format expected by the BLUE class
-    std::vector<double> x_est;
-    for (const auto& e : estimates) {
-      if (e.vals.size() != num_unc + 1)
-        throw std::runtime_error("Estimate '" + std::string(e.name) + "' has " + std::to_string(e.vals.size()) +
-                                 " values, expected " + std::to_string(num_unc + 1));
-      x_est.insert(x_est.end(), e.vals.begin(), e.vals.end());
+    // Perform the combinations, switching the set of active estimates
+    std::vector<Result> results;
+    for (const auto flag : flags) {
+      const auto& combination = combinations.at(flag);
+      auto& my_blue = combination.multi_obs ? blue_multi : blue_1d;
+      if (!my_blue) my_blue = init_blue(combination.multi_obs);
+
+      print_banner(combo_category, combination.title);
+      my_blue->ReleaseInp();
+      for (std::size_t i = 0; i < num_est; ++i) my_blue->SetInActiveEst(i);
+      for (const auto& input : combination.inputs) my_blue->SetActiveEst(index.at(input));
+      my_blue->FixInp();
+      my_blue->PrintEst();
+      my_blue->Solve();
+      my_blue->PrintResult();
+
+      const auto active = active_estimates(combination, index);
+      const auto active_obs = active_observables(combination, estimates, active);
+      if (active_obs.size() > 1) my_blue->PrintRhoRes();
+      if (print_jacobian) my_blue->PrintJacobian();
+      if (output.empty()) continue;
+
+      const auto n_obs = static_cast<int>(active_obs.size());
+      TMatrixD result(n_obs, num_unc + 1);
+      TMatrixD uncert(n_obs, 1);
+      TMatrixD weight(active.size(), n_obs);
+      TMatrixD rho_res(n_obs, n_obs);
+      TMatrixD jac_val(n_obs, my_blue->GetNumJac());
+      TMatrixD jac_cov(n_obs * n_obs, my_blue->GetNumJac());
+      my_blue->GetResult(&result);
+      my_blue->GetUncert(&uncert);
+      my_blue->GetWeight(&weight);
+      my_blue->GetRhoRes(&rho_res);
+      my_blue->GetJacVal(&jac_val);
+      my_blue->GetJacCov(&jac_cov);
+
+      Result r{flag, combination.title, {}, {}, {}, {}, {}, {}, {}, {}, {}, my_blue->GetChiq(), my_blue->GetNdof(),
+               my_blue->GetProb()};
+      for (const auto i : active) r.estimates.push_back(estimates[i].name);
+      for (int n = 0; n < n_obs; ++n) {
+        r.observables.push_back(trim(names_obs[active_obs[n]].Data()));
+        r.values.push_back(result(n, 0));
+        r.uncertainty.push_back(uncert(n, 0));
+        r.uncertainties.emplace_back();
+        for (size_t k = 0; k < num_unc; ++k) r.uncertainties.back().push_back(result(n, k + 1));
+        r.correlation.emplace_back();
+        for (int m = 0; m < n_obs; ++m) r.correlation.back().push_back(rho_res(n, m));
+        // The first columns of the Jacobian are the derivatives with respect to the correlation of each source
+        r.value_drho.emplace_back();
+        r.uncertainty_drho.emplace_back();
+        for (size_t k = 0; k < num_unc; ++k) {
+          r.value_drho.back().push_back(jac_val(n, k));
+          r.uncertainty_drho.back().push_back(0.5 * jac_cov(n * n_obs + n, k) / uncert(n, 0));
+        }
+      }
+      for (size_t i = 0; i < active.size(); ++i) {
+        r.weights.emplace_back();
+        for (int n = 0; n < n_obs; ++n) r.weights.back().push_back(weight(i, n));
+      }
+      results.push_back(std::move(r));
+    }
+    if (!output.empty()) {
+      write_results(output, combo_category, names_unc, results);
+      std::cout << "Results written to " << output.string() << std::endl;
     }
+  }
 
-    // Consistency checks
-    if (names_obs.size() != 1) throw std::runtime_error("Only 1D combinations are currently supported");
-    if (names_unc.size() != num_unc)
-      throw std::runtime_error("The number of uncertainty names is inconsistent with the number of uncertainties");
-    if (rho.size() != num_unc)
-      throw std::runtime_error("The size of the correlation vector is inconsistent with the number of uncertainties");
+  Average average(const Inputs& inputs, const int flag) {
+    const auto index = index_estimates(inputs.estimates);
+    validate(inputs.combinations, index);
+    const auto it = inputs.combinations.find(flag);
+    if (it == inputs.combinations.end()) throw std::runtime_error(std::format("Unknown combination {}", flag));
+    const auto& combination = it->second;
 
-    auto inp_est = std::make_unique<const TMatrixD>(num_est, num_unc + 1, &x_est[0]);
+    auto blue = make_blue(inputs.estimates, inputs.names_obs, inputs.names_unc, inputs.rho, combination.multi_obs);
+    blue->SetQuiet();
+    for (size_t i = 0; i < inputs.estimates.size(); ++i) blue->SetInActiveEst(i);
+    for (const auto& input : combination.inputs) blue->SetActiveEst(index.at(input));
+    blue->FixInp();
+    blue->Solve();
 
-    // Statistical precision in systematic uncertainties
-    const std::vector<double> s_unc(num_est * num_unc, 0.0);
-    auto inp_sta = std::make_unique<const TMatrixD>(num_est, num_unc, &s_unc[0]);
-
-    // Initialise the combiner
-    auto my_blue = std::make_unique<Blue>(num_est, num_unc);
-    my_blue->SetFormat(format.for_val, format.for_unc, format.for_wei, format.for_rho, format.for_pul, format.for_chi,
-                       format.for_uni);
-    my_blue->FillNamEst(&names[0]);
-    my_blue->FillNamUnc(&names_unc[0]);
-    my_blue->FillNamObs(&names_obs[0]);
-    my_blue->FillEst(inp_est.get());
-    my_blue->FillSta(inp_sta.get());
-    for (int i = 0; i < num_unc; ++i) my_blue->FillCor(i, rho[i]);
-
-    // Perform the combination
-    const auto [title, inputs] = combinations.at(flag);
-    print_banner(combo_category, title);
-    for (auto i = 0; i < num_est; ++i) my_blue->SetInActiveEst(i);
-    for (const auto& input : inputs) my_blue->SetActiveEst(index.at(input));
-    my_blue->FixInp();
-    my_blue->PrintEst();
-    my_blue->Solve();
-    my_blue->PrintResult();
+    const auto active_obs =
+        active_observables(combination, inputs.estimates, active_estimates(combination, index));
+    const auto n_obs = static_cast<int>(active_obs.size());
+    TMatrixD xva_res(n_obs, inputs.names_unc.size() + 1);
+    blue->GetResult(&xva_res);
+
+    // The first source is the statistical uncertainty, all others are systematic
+    Average avg{{}, {}, TMatrixDSym(n_obs), TMatrixDSym(n_obs)};
+    TMatrixD cov_res(n_obs, n_obs);
+    for (size_t k = 0; k < inputs.names_unc.size(); ++k) {
+      blue->GetCovRes(k, &cov_res);
+      auto& cov = k == 0 ? avg.cov_stat : avg.cov_syst;
+      for (int n = 0; n < n_obs; ++n)
+        for (int m = 0; m < n_obs; ++m) cov(n, m) += cov_res(n, m);
+    }
+    for (int n = 0; n < n_obs; ++n) {
+      avg.observables.push_back(trim(inputs.names_obs[active_obs[n]].Data()));
+      avg.values.push_back(xva_res(n, 0));
+    }
+    return avg;
   }
 
 }  // namespace BLUE
@@ -12,6 +12,18 @@ class CharmParameters : public ParametersAbs {
  public:
   CharmParameters();
 
+  /**
+   * Period of the angles flagged as periodic, i.e. the width of their physical range, and zero for all other
+   * parameters. Only the angles that enter the chi2 through their sine and cosine alone are periodic (e.g. delta_KK or
+   * phiM, but not Delta_Kpi, Delta_K3pi or Delta_Kpipi0, see CharmParameters.cpp). The fits of NuisanceProfiler let
+   * these angles wrap around their range, while the fits and scans of GammaCombo keep them bounded (see
+   * NuisanceProfiler.h).
+   */
+  static double period(const RooRealVar& var);
+
  private:
   void defineParameters();
+
+  /// Flag a parameter as periodic, with a period equal to its physical range, which must be a full turn.
+  static void setPeriodic(const Parameter* p);
 };
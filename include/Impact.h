@@ -0,0 +1,130 @@
+#pragma once
+
+#include <GammaComboEngine.h>
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Impact of each measurement on the parameters of a combination.
+ *
+ * With `--impact`, the executable does not run GammaCombo. Instead, for each combiner selected by `-c`, it fits the
+ * chi2 of the combiner (see NuisanceProfiler.h), and then refits a clone of the combiner once with each PDF removed.
+ * The refits start from the global minimum and run in parallel, each in its own forked process, since the PDFs share
+ * their parameters. The uncertainties are computed with HESSE.
+ *
+ * The shift of each parameter and the change of its uncertainty are printed, and written to
+ * `plots/impact/<engine_name>_<combiner_name>.json`, which contains the names of the parameters, their values and
+ * uncertainties in the global fit, and one entry per removed PDF with its id, title, chi2, Minuit2 status, and the
+ * shifts and changes of the uncertainties of all parameters (null for the parameters that are not constrained without
+ * the PDF).
+ *
+ * With `--impact-add <pdf>[,<pdf>...]`, the same invocation also refits a clone of the combiner once with each of these
+ * candidate PDFs added (the parameters that only they constrain float, too), and writes one more entry per added PDF,
+ * with the shifts and changes of the uncertainties with respect to the global fit, under "added". The candidates that
+ * are already in the combiner are skipped.
+ *
+ * With `--project <file>`, the executable instead projects the uncertainties of the parameters to the precisions of the
+ * scenarios listed in the file, one per line:
+ *
+ *    <name> [confirm] <pdf id>[:<observable>]=<scale>[/<systematic scale>] ...
+ *
+ * where the statistical and systematic uncertainties of all observables of the PDF (or only of the given observable)
+ * are multiplied by the scale factors (one factor scales both), the later factors overriding the earlier ones, and `#`
+ * starts a comment. The central values stay at the global minimum of the chi2 of the combiner. The uncertainties are
+ * obtained from the Fisher matrix of the theory of the PDFs linearised at the minimum, which needs no further fit. For
+ * the scenarios flagged with `confirm`, the PDFs are rebuilt with the scaled uncertainties and the Asimov data set of
+ * the global minimum, and the profile-likelihood intervals (where the chi2 rises by one) are computed with a clone of
+ * the combiner combined from them, each scenario in its own forked process. The results are printed and written to
+ * `plots/projection/<engine_name>_<combiner_name>.json`.
+ *
+ * With `--preview`, the executable replaces the scan of the one or two parameters selected by `--var` with its Gaussian
+ * approximation, from the covariance computed by HESSE at the global minimum of the chi2 of the combiner. The 1, 2 and
+ * 3 sigma intervals (and, for two parameters, their correlation and the axes of the 1, 2 and 3 sigma ellipses) are
+ * printed, and the grid set by `--scanrange`, `--scanrangey`, `--npoints`, `--npoints2dx` and `--npoints2dy` (by
+ * default +- 4 sigma around the minimum) is written in the columnar format of the scans (see ScanColumns.h) to
+ * `plots/columns/<engine_name>_preview_<combiner_name>_<var1>[_<var2>]/`, with 1 - CL computed for one degree of
+ * freedom per scanned parameter. The values, uncertainties and correlations of all parameters are written to
+ * `plots/preview/<engine_name>_<combiner_name>.json`. Both outputs are labelled as a Gaussian approximation (in the
+ * source of meta.json and in the JSON file), and the Python driver marks them as such in the legends.
+ *
+ * With `--multistart <n>`, the executable fits each combiner from `n` start points instead, to find the secondary
+ * minima of the chi2 of the combiner (e.g. those of the strong phases). The start points fill a Latin hypercube over
+ * the scan ranges of the floating parameters (see CharmParameters.cpp), drawn with the seed set by
+ * `--multistart-seed <n>` (1 by default), and the fits run in parallel forked processes. The combiner is then refitted
+ * from the best of them, which leaves its parameters at the global minimum. The distinct minima (those differing by
+ * more than 0.1 sigma in at least one parameter) are printed, and written in order of increasing chi2 to the start
+ * parameter file `plots/multistart/<engine_name>_<combiner_name>_<n>starts_seed<seed>.dat`, which seeds the scans
+ * with the GammaCombo option `--parfile`.
+ *
+ * With `--derived <name>[=<expression>]`, the executable scans a quantity derived from the parameters instead, given
+ * as a RooFormulaVar formula of their names (e.g. `--derived "x12_sin_phiM=x12*sin(phiM)"`), or only by its name for
+ * the quantities predefined by the executable (e.g. DY_RS, the absolute value of DeltaY(K- pi+)). The chi2 of the
+ * combiner is profiled with the quantity constrained exactly at each point of the grid (see NuisanceProfiler.h), which
+ * replaces a pseudo-measurement of the quantity with a negligible uncertainty (such as PDF_scan_DY_RS). Two
+ * quantities, or one together with a parameter selected by `--var`, are scanned in 2D. The grid is set by the same
+ * options as for `--preview`. By default, it spans +- 4 sigma around the minimum (propagated linearly), clipped to the
+ * domain of the predefined quantities and to the limits of the parameters; the range of the other quantities must be
+ * set with `--scanrange` (and `--scanrangey`). The rows of the grid are scanned in parallel forked processes. The
+ * points whose fit failed are reported and masked with NaN. The scan is written with 1 - CL computed for one degree
+ * of freedom per scanned quantity,
+ *
+ *  - in the format of the GammaCombo scans read by the Python driver (`get_scan_res`), i.e. the histograms hCL and
+ *    hChi2min in `plots/scanner/<engine_name>_derived_scanner_<combiner_name>_<var>[_<var>].root`, and the global
+ *    minimum (including the scanned quantities) in `plots/par/<engine_name>_derived_<combiner_name>_<var>[_<var>].dat`;
+ *  - in the columnar format (see ScanColumns.h) in
+ *    `plots/columns/<engine_name>_derived_<combiner_name>_<var>[_<var>]/`, with the status of the fit at each point.
+ */
+namespace impact {
+  /// Quantity derived from the parameters that can be scanned by its name only (see scan_derived).
+  struct PredefinedQuantity {
+    std::string expression;  ///< Function of the parameters, in the syntax of RooFormulaVar.
+    double min;              ///< Lower end of the physical domain, which bounds the default grid.
+    double max;              ///< Upper end of the physical domain.
+  };
+
+  /**
+   * Print and write the impact tables of all combiners selected by the GammaCombo option `-c` in `args`, the arguments
+   * passed to GammaComboEngine. The parameters set with the GammaCombo option `--fix <name>=<value>[,...]` are kept
+   * constant in all fits.
+   *
+   * @param candidates Values of `--impact-add`: comma-separated ids of the PDFs whose addition is refitted, too.
+   */
+  void run(GammaComboEngine& gc, const std::string& engine_name, const std::vector<char*>& args,
+           const std::vector<std::string>& candidates = {});
+
+  /**
+   * Print and write the projected uncertainties of all combiners selected by `-c` in `args` for the scenarios in
+   * `scenario_file`, keeping constant the parameters set with `--fix`, as for `run`.
+   */
+  void project(GammaComboEngine& gc, const std::string& engine_name, const std::vector<char*>& args,
+               const std::filesystem::path& scenario_file);
+
+  /**
+   * Print and write the Gaussian approximation of the scan of the parameters selected by `--var` in `args`, for all
+   * combiners selected by `-c`, keeping constant the parameters set with `--fix`, as for `run`.
+   */
+  void preview(GammaComboEngine& gc, const std::string& engine_name, const std::vector<char*>& args);
+
+  /**
+   * Print and write the distinct minima found by fitting all combiners selected by `-c` in `args` from `num_starts`
+   * start points, keeping constant the parameters set with `--fix`, as for `run`.
+   *
+   * @param seed Seed of the random generator of the start points.
+   */
+  void multistart(GammaComboEngine& gc, const std::string& engine_name, const std::vector<char*>& args,
+                  int num_starts, unsigned seed);
+
+  /**
+   * Write the profile-likelihood scan of the derived quantities `derived` (and of the parameter selected by `--var` in
+   * `args`, if any), for all combiners selected by `-c`, keeping constant the parameters set with `--fix`, as for
+   * `run`.
+   *
+   * @param predefined Quantities that can be selected only by their name.
+   */
+  void scan_derived(GammaComboEngine& gc, const std::string& engine_name, const std::vector<char*>& args,
+                    const std::vector<std::string>& derived,
+                    const std::map<std::string, PredefinedQuantity>& predefined);
+}  // namespace impact
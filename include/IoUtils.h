@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Input and output helpers shared by the executables of the charm fitter: parsing of the command-line options
+ * that are not passed on to GammaCombo, and JSON output.
+ */
+namespace io {
+  /// Remove all occurrences of `flag` from argv, and return whether it was found.
+  inline bool parse_flag(int& argc, char* argv[], const char* flag) {
+    bool found = false;
+    int j = 0;
+    for (int i = 0; i < argc; ++i) {
+      if (!strcmp(argv[i], flag))
+        found = true;
+      else
+        argv[j++] = argv[i];
+    }
+    argc = j;
+    return found;
+  }
+
+  /// Remove all occurrences of `option <value>` from argv, and return their values in order.
+  inline std::vector<std::string> parse_option(int& argc, char* argv[], const char* option) {
+    std::vector<std::string> values;
+    int j = 0;
+    for (int i = 0; i < argc; ++i) {
+      if (!strcmp(argv[i], option)) {
+        if (i + 1 == argc) throw std::runtime_error(std::format("io::parse_option ERROR {} requires a value", option));
+        values.push_back(argv[++i]);
+      } else {
+        argv[j++] = argv[i];
+      }
+    }
+    argc = j;
+    return values;
+  }
+
+  /// Remove all occurrences of `option <value>` from argv, and return the last value, if any.
+  inline std::optional<std::string> parse_last_option(int& argc, char* argv[], const char* option) {
+    const auto values = parse_option(argc, argv, option);
+    if (values.empty()) return std::nullopt;
+    return values.back();
+  }
+
+  /// Values of the option `name` in the arguments `args` passed to GammaCombo, in order, without removing them.
+  inline std::vector<std::string> option_values(const std::vector<char*>& args, const char* name) {
+    std::vector<std::string> values;
+    for (std::size_t i = 0; i + 1 < args.size(); ++i) {
+      if (!strcmp(args[i], name)) values.push_back(args[i + 1]);
+    }
+    return values;
+  }
+
+  /// Values of the GammaCombo option `--fix <name>=<value>[,...]` in `args`, the later values overriding the earlier.
+  inline std::map<std::string, double> fixed_values(const std::vector<char*>& args) {
+    std::map<std::string, double> fixed;
+    for (const auto& option : option_values(args, "--fix")) {
+      std::stringstream list(option);
+      for (std::string item; std::getline(list, item, ',');) {
+        const auto eq = item.find('=');
+        if (eq == std::string::npos) {
+          throw std::runtime_error(std::format("io::fixed_values ERROR Cannot parse \"{}\" of option --fix", item));
+        }
+        fixed[item.substr(0, eq)] = std::stod(item.substr(eq + 1));
+      }
+    }
+    return fixed;
+  }
+
+  inline std::string json_string(const std::string& str) {
+    std::string escaped = "\"";
+    for (const auto c : str) {
+      if (c == '"' || c == '\\') escaped += '\\';
+      escaped += c;
+    }
+    return escaped + "\"";
+  }
+
+  /// Shortest representation that reads back to the same double, or null if it is not finite.
+  inline std::string json_number(const double val) { return std::isfinite(val) ? std::format("{}", val) : "null"; }
+
+  template <typename T, typename F>
+  std::string json_list(const std::vector<T>& items, F&& to_json) {
+    std::string list = "[";
+    for (const auto& item : items) list += (list.size() > 1 ? ", " : "") + to_json(item);
+    return list + "]";
+  }
+
+  inline std::string json_matrix(const std::vector<std::vector<double>>& rows) {
+    return json_list(rows, [](const std::vector<double>& row) { return json_list(row, json_number); });
+  }
+}  // namespace io
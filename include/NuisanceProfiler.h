@@ -0,0 +1,116 @@
+#pragma once
+
+#include <Combiner.h>
+
+#include <RooAbsPdf.h>
+#include <RooArgSet.h>
+#include <RooFormulaVar.h>
+#include <RooRealVar.h>
+
+#include <TMatrixDSym.h>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Profile of all parameters along a scan, obtained by minimising the chi2 of a GammaCombo combiner at fixed values of
+ * the scanned parameters.
+ *
+ * The chi2 is -2 log of the (unnormalised) product of the PDFs combined in the workspace of the combiner, i.e. the
+ * function that GammaCombo minimises in its own fits and scans.
+ *
+ * The periodic angles (see CharmParameters::period) are not bounded in the minimisation. Their values wrap around
+ * their range instead, so that minima close to the edges of the range are found without hitting a limit.
+ * This holds for all fits of this class, i.e. for those of --impact, --project, --preview, --multistart and --derived
+ * and for the side tables of --save-nuisances, but NOT for the fits and scans run by GammaCombo itself (those writing
+ * the scanner files), which minimise in the GammaCombo core with the angles bounded by their RooRealVar limits. The
+ * wrapping therefore does not reduce the failed fits of those scans.
+ *
+ * Quantities derived from the parameters (e.g. DeltaY(K- pi+) from the mixing parameters) can be scanned, too. Each of
+ * them is constrained exactly to its value with an augmented Lagrangian: the chi2 is minimised with the penalty
+ * lambda * g + mu * g^2 added for the deviation g of the quantity from its value, the multiplier lambda is then moved
+ * by 2 * mu * g and the minimisation repeated, until the deviation is below 1e-4 times the scale of the quantity. The
+ * scale is the uncertainty of the quantity propagated linearly from the step sizes of the parameters or, if the
+ * quantity does not depend on them at the start of the fit, the magnitude of its target (or else current) value. The
+ * weight mu starts from that of a measurement of the quantity with an uncertainty equal to its scale, and grows only if
+ * the deviation does not shrink fast enough, so that the chi2 stays well conditioned (unlike with a pseudo-measurement
+ * of tiny uncertainty).
+ */
+class NuisanceProfiler {
+ public:
+  /// Result of the fit at one scan point.
+  struct Result {
+    std::vector<double> values;  ///< Values of all parameters, in the order of `parameters()`.
+    std::vector<double> errors;  ///< Uncertainties of all parameters, zero for those that do not float.
+    double chi2;
+    int status;              ///< Status returned by Minuit2 (0 if the fit converged), -1 if a constraint was not met.
+    int ncalls;              ///< Number of chi2 evaluations, summed over all minimisations of the fit.
+    TMatrixDSym covariance;  ///< Covariance of all parameters computed by HESSE, zero for those that do not float.
+  };
+
+  /// Quantity derived from the parameters, which can be scanned like a parameter.
+  struct Derived {
+    std::string name;
+    std::string expression;  ///< Function of the parameters, in the syntax of RooFormulaVar.
+  };
+
+  /**
+   * @param combiner Combiner whose chi2 is minimised. It is combined first, if GammaCombo did not do it yet.
+   * @param floating Names of the parameters that float in the fits. All other parameters are kept constant.
+   * @param scan_vars Names of the scanned parameters, which are fixed in each fit.
+   * @param derived Derived quantities, which are constrained in the fits given their values.
+   */
+  NuisanceProfiler(Combiner& combiner, const std::vector<std::string>& floating,
+                   const std::vector<std::string>& scan_vars, const std::vector<Derived>& derived = {});
+
+  /// Combine the PDFs of `combiner` in its workspace, if not done yet, and return the parameters of its chi2.
+  static const RooArgSet& combinedParameters(Combiner& combiner);
+
+  /// Names of all parameters of the chi2, in alphabetical order.
+  const std::vector<std::string>& parameters() const { return names; }
+
+  /// Set the value of a parameter (and its step size in the fit, if positive).
+  void setValue(const std::string& name, double value, double step = -1.);
+
+  /**
+   * Values of the derived quantities at the parameters of `result`, and their uncertainties propagated linearly from
+   * its covariance. The parameters are left unchanged.
+   */
+  std::vector<std::pair<double, double>> derivedValues(const Result& result);
+
+  /**
+   * Minimise the chi2 at the given values of the scanned parameters, followed by those of the derived quantities. If
+   * the latter are omitted, the derived quantities are not constrained. Throws if the scale of a constrained quantity
+   * (see above) is zero.
+   *
+   * @param start Values of all parameters, in the order of `parameters()`, where the minimisation starts from. If
+   *              empty, it starts from the result of the previous fit.
+   * @param hesse Whether to compute the uncertainties with HESSE, instead of taking those estimated by MIGRAD.
+   */
+  Result fit(const std::vector<double>& scan_values, const std::vector<double>& start = {}, bool hesse = false);
+
+ private:
+  struct Parameter {
+    RooRealVar* var;  ///< Parameter in the workspace of the combiner.
+    double value;
+    double step;
+    double period;  ///< Period of the periodic angles, zero for the other parameters.
+    bool floating;
+  };
+
+  void set(Parameter& par, double value);
+  double chi2() const;
+  /// Gradient of the derived quantity `k` with respect to the `floating` parameters, for steps of size `steps`.
+  std::vector<double> gradient(std::size_t k, const std::vector<Parameter*>& floating,
+                               const std::vector<double>& steps);
+
+  std::vector<const RooAbsPdf*> factors;  ///< Factors of the combined PDF of the combiner.
+  std::vector<std::string> names;
+  std::map<std::string, Parameter> pars;
+  std::vector<std::string> scanVars;
+  std::vector<std::unique_ptr<RooFormulaVar>> derived;
+};
@@ -0,0 +1,61 @@
+/**
+ * Charm Combination
+ * Author: tommaso.pajero@cern.ch
+ * Date: October 2026
+ **/
+
+#pragma once
+
+#include <PDF_Charm.h>
+
+#include <BLUE/Utils.h>
+
+#include <TString.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * Models the result of a BLUE combination (see BLUE/include/BLUE/Utils.h), which is solved in-process when the PDF is
+ * constructed. The averaged values and their covariance are thus never transcribed by hand, and a change to a BLUE
+ * estimate propagates to the fit with the next build.
+ *
+ * The statistical uncertainties are those of the first uncertainty source of the BLUE inputs, and the systematic
+ * uncertainties sum all other sources, including their correlations between observables.
+ */
+class PDF_BLUE : public PDF_Charm {
+ public:
+  /// Theory prediction of one of the averaged observables.
+  struct Observable {
+    std::string blue_name;   ///< Name of the observable in the BLUE inputs (see `BLUE::Inputs::names_obs`).
+    std::string name;        ///< Name of the RooFit variables, with suffix "_obs" and "_th".
+    std::string title;       ///< Title of the observable.
+    std::string expression;  ///< Theory expression.
+  };
+
+  /**
+   * @param measurement_id Name of the measurement, used in the name of the PDF.
+   * @param inputs Definition of the BLUE combinations.
+   * @param flag Flag of the combination to be solved.
+   * @param unit Unit of the BLUE inputs (e.g. 1e-4), by which the averages are multiplied.
+   * @param observables One theory prediction per averaged observable, in any order.
+   * @param parameter_names Parameters of the theory expressions.
+   */
+  PDF_BLUE(TString measurement_id, const BLUE::Inputs& inputs, int flag, double unit,
+           const std::vector<Observable>& observables, std::set<std::string> parameter_names);
+  void initObservables() override;
+  void initRelations() override;
+  void setCorrelations(TString measurement_id) override;
+  void setObservables(TString measurement_id) override;
+  void setUncertainties(TString measurement_id) override;
+
+ private:
+  std::set<std::string> getParameterNames() const override;
+  const BLUE::Average average;
+  const double unit;
+  const std::set<std::string> parameterNames;
+  const TString measurement_id;
+  /// Theory predictions, in the order of the averaged observables.
+  std::vector<Observable> observables_th;
+};
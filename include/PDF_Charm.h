@@ -2,10 +2,14 @@
 
 #include <PDF_Abs.h>
 
+#include <RooArgList.h>
+
+#include <TMatrixDSym.h>
 #include <TString.h>
 
 #include <set>
 #include <string>
+#include <vector>
 
 /**
  * Utility class for charm PDFs, to avoid boilerplate code in each PDF class.
@@ -17,6 +21,30 @@ class PDF_Charm : public PDF_Abs {
   void buildPdf() override;
   /// Default for single-observable PDFs; PDFs with more than one observable must override this.
   void setCorrelations(TString c) override;
+  /**
+   * Summary of all inputs of the PDF: name, theory expressions, observed values, uncertainties and correlations.
+   * Used by the scan cache, which reruns a scan only if the fingerprint of one of its PDFs changes.
+   */
+  std::string fingerprint() const;
+  /// Parameters of the theory expressions.
+  const RooArgList& theoryParameters() const { return *parameters; }
+  /// Observables, with the measured values.
+  const RooArgList& measuredObservables() const { return *observables; }
+  /// Theory expressions of the observables, in the order of the observables.
+  const RooArgList& theoryExpressions() const { return *theory; }
+  /// Covariance matrix of the observables.
+  const TMatrixDSym& covariance() const { return covMatrix; }
+  /**
+   * Covariance matrix of the observables with their statistical and systematic uncertainties scaled by the given
+   * factors, e.g. to project the combination to a future precision. The systematic covariance is the difference of the
+   * total and statistical ones.
+   */
+  TMatrixDSym covariance(const std::vector<double>& stat_scale, const std::vector<double>& syst_scale) const;
+  /**
+   * Scale the statistical and systematic uncertainties of the observables by the given factors, as for `covariance`,
+   * and rebuild the PDF. A combiner must be combined anew to see the change.
+   */
+  void scaleUncertainties(const std::vector<double>& stat_scale, const std::vector<double>& syst_scale);
 
  protected:
   /**
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <GammaComboEngine.h>
+
+#include <string>
+
+/**
+ * Support for the content-addressed cache of scan results kept by the Python driver (see `ScanCache` in
+ * src/charm_fitter/utils.py).
+ *
+ * When an executable is run with `--fingerprint`, it prints the inputs of all its PDFs and combiners instead of running
+ * the combination. The driver hashes the fingerprints of the PDFs entering a scan, together with the scan command, the
+ * executable and the start parameter files it reads, and skips the scan if the hash did not change since the last
+ * successful run.
+ */
+namespace scan_cache {
+  /**
+   * Identifier of the build of the fit, i.e. a hash of the shared libraries holding the PDFs and fits of the fitter
+   * and of GammaCombo, so that rebuilding them with any change invalidates all cached scans. The driver hashes the
+   * executable itself.
+   */
+  std::string build_id();
+
+  /**
+   * Print the fingerprints of all PDFs and combiners of `gc`, one per line, in the format
+   *
+   *     FINGERPRINT <engine_name> version <build_id> ROOT-<ROOT release>
+   *     FINGERPRINT <engine_name> pdf <pdf_id> <fingerprint>
+   *     FINGERPRINT <engine_name> combiner <combiner_id> <comma-separated pdf ids>
+   */
+  void print_fingerprints(GammaComboEngine& gc, const std::string& engine_name);
+}  // namespace scan_cache
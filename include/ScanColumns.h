@@ -0,0 +1,118 @@
+#pragma once
+
+#include <PDF_Charm.h>
+
+#include <Combiner.h>
+#include <GammaComboEngine.h>
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Columnar copy of the scanner ROOT files, which can be memory-mapped from Python without ROOT (see
+ * `read_scan_columns` in src/charm_fitter/utils.py).
+ *
+ * The scanner file `plots/scanner/<name>.root` is copied to the directory `plots/columns/<name>/`, which contains one
+ * NumPy (.npy, format 1.0, little-endian) file per column:
+ *
+ *     x.npy, y.npy      Bin centres of the scanned variables (y only for 2D scans).
+ *     cl.npy            1 - CL at each scan point, with shape (nx,) or (nx, ny).
+ *     chi2min.npy       Minimum chi2 at each scan point, with the same shape as cl.npy.
+ *     solutions.npy     Values of the floating parameters at the local minima found by the scan, with shape
+ *                       (n_solutions, n_parameters).
+ *     meta.json         Format version, source file, axis titles, names of the parameters in solutions.npy and
+ *                       minimum NLL of each solution.
+ *
+ * The values are copied bit by bit from the histograms and fit results in the ROOT file, and every column is read back
+ * and compared with them after being written.
+ *
+ * GammaCombo does not save the parameters at each scan point. With `--save-nuisances`, they are obtained by refitting
+ * the chi2 of the combiner, the same that GammaCombo minimised, at each point of the grid (see NuisanceProfiler.h),
+ * with the parameters set by the GammaCombo option `--fix` kept constant as in the scan. They are stored in the side
+ * table
+ *
+ *     nuisances.npy     Values of all parameters, with shape (nx, n_parameters) or (nx, ny, n_parameters).
+ *     chi2.npy          Chi2 of the refit, with the same shape as cl.npy. The points where it differs from chi2min.npy
+ *                       by more than 0.01 (i.e. where the refit and the scan found different minima) are reported.
+ *     status.npy        Minuit2 status of the refit (int32, 0 if the fit converged), with the same shape as cl.npy.
+ *     ncalls.npy        Number of chi2 evaluations of the refit (int32), with the same shape as cl.npy.
+ *
+ * with the names of the parameters listed in meta.json. Each refit starts from the parameters stored at the same point
+ * by the previous run, if the grid and parameters did not change, or else from the result at the previous point.
+ *
+ * The side table does not come from the fits of the GammaCombo scan: GammaCombo keeps their results in memory only,
+ * without writing them to the scanner file nor exposing them through GammaComboEngine. The refits therefore roughly
+ * double the cost of a scan, and the warm start from nuisances.npy only speeds up the refits, not the GammaCombo scan,
+ * which still starts from its own start parameter files in plots/par/.
+ *
+ * The scans computed without GammaCombo by profiling the chi2 at each point (see `write`) save instead the Minuit2
+ * status of each fit in status.npy, where cl.npy and chi2min.npy are NaN at the points whose fit failed.
+ */
+namespace scan_columns {
+  /// Bump when the layout of the columns changes.
+  constexpr int version = 1;
+
+  /// Options of the executables controlling the columnar copies.
+  struct Options {
+    bool save_nuisances = false;          ///< Set by `--save-nuisances`.
+    std::vector<std::string> combiners;   ///< Values of the GammaCombo option `-c`.
+    std::vector<std::string> vars;        ///< Values of the GammaCombo option `--var`.
+    std::map<std::string, double> fixed;  ///< Values of the GammaCombo option `--fix`.
+  };
+
+  /// Combiner selected by the GammaCombo option `-c`.
+  struct SelectedCombiner {
+    std::string name;  ///< Name used in the output files.
+    int id;            ///< Id of the combiner in the GammaComboEngine.
+    std::vector<const PDF_Charm*> pdfs;
+  };
+
+  /// Remove `--save-nuisances` from argv, if present, and read the GammaCombo options selecting the scans.
+  Options parse_options(int& argc, char* argv[]);
+
+  /**
+   * Combiner selected by the GammaCombo option `-c <arg>`. If `<arg>` adds PDFs to a combiner, they are added to a
+   * clone of it with a free id. Returns nothing if the combiner does not exist, if one of its PDFs is not a PDF_Charm,
+   * or if `<arg>` does not only add PDFs to it.
+   */
+  std::optional<SelectedCombiner> resolve_combiner(GammaComboEngine& gc, const std::string& arg);
+
+  /// Clone the combiner `id` to the first free id from 1000 on, and return the id. The clone is not combined yet.
+  int clone_combiner(GammaComboEngine& gc, int id);
+
+  /**
+   * Copy the scanner file `scanner_file` to `plots/columns/<stem>/`. Files without 1 - CL and chi2 histograms (e.g.
+   * those of plugin scans) are skipped.
+   *
+   * @param combiner Scanned combiner. If given, the side table of the parameters is saved, too.
+   * @param scan_vars Names of the scanned parameters (only used with `combiner`).
+   * @param fixed Parameters set by the GammaCombo option `--fix` (only used with `combiner`).
+   */
+  void convert(const std::filesystem::path& scanner_file, Combiner* combiner = nullptr,
+               const std::vector<std::string>& scan_vars = {}, const std::map<std::string, double>& fixed = {});
+
+  /**
+   * Write a scan computed without GammaCombo (see impact::preview and impact::scan_derived) to
+   * `plots/columns/<name>/`, with the same columns as the copies of the scanner files and without the side table.
+   *
+   * @param axes Bin centres of the scanned variables.
+   * @param cl 1 - CL at each scan point, in C order.
+   * @param chi2min Minimum chi2 at each scan point, in C order.
+   * @param status Minuit2 status of the fit at each scan point (0 if it converged), in C order, saved as status.npy.
+   *               Empty for the scans without a fit at each point (e.g. the previews). The caller masks the failed
+   *               points with NaN in `cl` and `chi2min`.
+   * @param solution Values of the floating `parameters` at the global minimum, where -log(L) is `min_nll`.
+   */
+  void write(const std::string& name, const std::string& source, const std::vector<std::string>& axis_titles,
+             const std::vector<std::vector<double>>& axes, const std::vector<double>& cl,
+             const std::vector<double>& chi2min, const std::vector<int>& status,
+             const std::vector<std::string>& parameters, const std::vector<double>& solution, double min_nll);
+
+  /// Copy all scanner files of the engine `engine_name` written since `since`.
+  void convert_new(GammaComboEngine& gc, const std::string& engine_name, std::filesystem::file_time_type since,
+                   const Options& options);
+}  // namespace scan_columns
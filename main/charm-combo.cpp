@@ -1,11 +1,19 @@
 // Core
 #include <Combiner.h>
 #include <GammaComboEngine.h>
+#include <PDF_Abs.h>
+
+#ifdef CHARM_FITTER_WITH_BLUE
+#include <BLUE/DY.h>
+#endif
 
 // CharmFitter
 #include <CharmUtils.h>
 #include <PDF_AcpHH_LHCb_Run12.h>
 #include <PDF_BES_CLEO_K3pi_Kpipi0.h>
+#ifdef CHARM_FITTER_WITH_BLUE
+#include <PDF_BLUE.h>
+#endif
 #include <PDF_BES_Kpi.h>
 #include <PDF_BES_Kpi_pipipi0.h>
 #include <PDF_BinFlip.h>
@@ -26,14 +34,35 @@
 #include <PDF_yCP_minus_yCP_KP.h>
 #include <PDF_yCP_minus_yCP_RS.h>
 #include <PDF_yCP_plus_yCP_RS.h>
-
+#include <Impact.h>
+#include <IoUtils.h>
+#include <ScanCache.h>
+#include <ScanColumns.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
 #include <format>
+#include <limits>
+#include <map>
 #include <set>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace {
+  /**
+   * PDF of the world average of DeltaY(h- h+) in 2021 entering the combiners: the one solved in-process by BLUE (74) if
+   * the BLUE library is built, or else the hand-copied one (72).
+   */
+#ifdef CHARM_FITTER_WITH_BLUE
+  constexpr int dy_wa2021 = 74;
+#else
+  constexpr int dy_wa2021 = 72;
+#endif
+
   std::vector<int> get_lhcb_pdfs(const std::string run, const hypotheses::dy_fsc dy_fsc_hypo) {
     std::vector<int> pdfs;
     if (run == "run12") {
@@ -45,7 +74,7 @@ namespace {
           35,  // WS               DT Run 1
           39,  // WS               Prompt Run 1+2
           64,  // yCP_minus_yCP_RS WA 2022
-          72,  // DY average
+          dy_wa2021,  // DY average
           90,  // AcpHH
       };
       if (dy_fsc_hypo == hypotheses::dy_fsc::none) {
@@ -62,11 +91,17 @@ namespace {
   using parametrisations::acp;
   using parametrisations::mix;
 
-  struct ParsedArgs {
+  /// One configuration of the combination, i.e. a choice of DeltaY final-state correction and parametrisations.
+  struct Variant {
     dy_fsc dy_fsc_hypo;
     acp acp_param;
     mix mix_param;
+  };
+
+  struct ParsedArgs {
+    std::vector<Variant> variants;
     bool dcs_cpv;
+    bool fingerprint;
     bool help;
     std::vector<char*> combiner_argv;
   };
@@ -99,27 +134,79 @@ namespace {
               << "  --mix [" << join_ids(supported_mix) << "]  (default: " << utils::get_id(mix::theo) << ")\n"
               << "      Choose the mixing parametrisation.\n"
               << "      Changes the combiner name to <combiner-name>_<mix>.\n\n"
+              << "      The three options above also accept a comma-separated list of values, e.g.\n"
+              << "      `--dy-fsc no,full`. All compatible combinations of the values are then run one after the\n"
+              << "      other in the same process, building the PDFs that do not depend on the DeltaY(h- h+)\n"
+              << "      correction nor on the aCP(h- h+) parametrisation only once per mixing parametrisation.\n\n"
               << "  --dcs-cpv\n"
               << "      Allow for CP violation in doubly Cabibbo-suppressed D0 -> K+ pi- decays.\n"
               << "      Changes the combiner name to <combiner-name>_dcs-cpv. If not set, `--fix Acp_KP=0` is\n"
               << "      automatically passed to GammaComboEngine.\n\n"
+              << "  --derived <name>[=<expression>]\n"
+              << "      Instead of running GammaCombo, scan a quantity derived from the parameters, constrained\n"
+              << "      exactly at each point, e.g. --derived DY_RS or --derived \"x12_sin_phiM=x12*sin(phiM)\".\n"
+              << "      Can be repeated, or combined with --var, for 2D scans (see include/Impact.h and\n"
+              << "      plots/columns/).\n\n"
+              << "  --fingerprint\n"
+              << "      Print the inputs of all PDFs and combiners, as used by the scan cache of the Python driver,\n"
+              << "      instead of running the combination.\n\n"
+              << "  --impact\n"
+              << "      Instead of running GammaCombo, refit each combiner selected by -c with each of its PDFs\n"
+              << "      removed, and print and save the shifts and changes of the uncertainties of all parameters\n"
+              << "      (see plots/impact/).\n\n"
+              << "  --impact-add <pdf>[,<pdf>...]\n"
+              << "      With --impact, also refit each combiner with each of these PDFs added.\n\n"
+              << "  --multistart <n>\n"
+              << "      Instead of running GammaCombo, fit each combiner selected by -c from n start points, and\n"
+              << "      print and save its distinct minima as a start parameter file for --parfile (see\n"
+              << "      plots/multistart/).\n\n"
+              << "  --multistart-seed <n>\n"
+              << "      Seed of the start points of --multistart (default: 1).\n\n"
+              << "  --preview\n"
+              << "      Instead of running GammaCombo, write the Gaussian approximation of the scan selected by\n"
+              << "      --var, from the HESSE covariance at the global minimum, in the format of the scans\n"
+              << "      (see plots/columns/ and plots/preview/).\n\n"
+              << "  --project <file>\n"
+              << "      Instead of running GammaCombo, project the uncertainties of the parameters of each\n"
+              << "      combiner selected by -c to the precisions of the scenarios listed in <file> (see\n"
+              << "      include/Impact.h and plots/projection/).\n\n"
+              << "  --save-nuisances\n"
+              << "      Refit the combiner at each point of the scan grid, and save all parameters, the fit\n"
+              << "      status and the number of function calls next to the columnar copy of the scanner file\n"
+              << "      (see plots/columns/).\n\n"
               << "-------------------------------------------------------------------------------------------"
               << std::endl;
   }
 
+  /// Match `value` against the id string of one of `supported`.
+  template <typename Enum>
+  Enum parse_enum_value(const char* value, const char* flag, const std::set<Enum>& supported) {
+    for (auto val : supported) {
+      if (!strcmp(value, utils::get_id(val).c_str())) { return val; }
+    }
+    throw std::runtime_error(std::format("main ERROR Option \"{}\" is not supported by \"{}\"", value, flag));
+  }
+
   /**
-   * Parse a `--<flag> <value>` pair out of argv, matching `value` against the id string of one of `supported`, and
-   * write the result to `out`. Marks both tokens for removal from the argv that gets forwarded to GammaComboEngine.
+   * Parse a `--<flag> <value>[,<value>...]` pair out of argv, matching each comma-separated value against the id
+   * string of one of `supported`, and return the list of values in the order they are given (repetitions are
+   * dropped). Marks both tokens for removal from the argv that gets forwarded to GammaComboEngine.
    */
   template <typename Enum>
-  Enum parse_enum_option(const int argc, char* argv[], const int i, const char* flag, const std::set<Enum>& supported,
-                         std::set<int>& to_remove) {
+  std::vector<Enum> parse_enum_option(const int argc, char* argv[], const int i, const char* flag,
+                                      const std::set<Enum>& supported, std::set<int>& to_remove) {
     if (i == argc - 1) throw std::runtime_error(std::format("main ERROR Option \"{}\" requires an argument", flag));
     to_remove.insert({i, i + 1});
-    for (auto val : supported) {
-      if (!strcmp(argv[i + 1], utils::get_id(val).c_str())) { return val; }
+    std::vector<Enum> values;
+    std::stringstream list(argv[i + 1]);
+    std::string token;
+    while (std::getline(list, token, ',')) {
+      const auto val = parse_enum_value(token.c_str(), flag, supported);
+      if (std::find(values.begin(), values.end(), val) == values.end()) values.push_back(val);
     }
-    throw std::runtime_error(std::format("main ERROR Option \"{}\" is not supported by \"{}\"", argv[i + 1], flag));
+    if (values.empty())
+      throw std::runtime_error(std::format("main ERROR Option \"{}\" requires at least one value", flag));
+    return values;
   }
 
   /**
@@ -127,28 +214,56 @@ namespace {
    * by GammaComboEngine.
    */
   ParsedArgs parse_args(int argc, char* argv[]) {
-    dy_fsc dy_fsc_hypo = dy_fsc::none;
-    acp acp_param = acp::acp_dy;
-    mix mix_param = mix::theo;
+    std::vector<dy_fsc> dy_fsc_hypos{dy_fsc::none};
+    std::vector<acp> acp_params{acp::acp_dy};
+    std::vector<mix> mix_params{mix::theo};
     bool dcs_cpv = false;
+    bool fingerprint = false;
     bool help = false;
 
     std::set<int> to_remove;
     for (int i = 1; i < argc; ++i) {
       if (!strcmp(argv[i], "--dy-fsc")) {
-        dy_fsc_hypo = parse_enum_option(argc, argv, i, "--dy-fsc", supported_dyfsc, to_remove);
+        dy_fsc_hypos = parse_enum_option(argc, argv, i, "--dy-fsc", supported_dyfsc, to_remove);
       } else if (!strcmp(argv[i], "--acp")) {
-        acp_param = parse_enum_option(argc, argv, i, "--acp", supported_acp, to_remove);
+        acp_params = parse_enum_option(argc, argv, i, "--acp", supported_acp, to_remove);
       } else if (!strcmp(argv[i], "--mix")) {
-        mix_param = parse_enum_option(argc, argv, i, "--mix", supported_mix, to_remove);
+        mix_params = parse_enum_option(argc, argv, i, "--mix", supported_mix, to_remove);
       } else if (!strcmp(argv[i], "--dcs-cpv")) {
         dcs_cpv = true;
         to_remove.insert(i);
+      } else if (!strcmp(argv[i], "--fingerprint")) {
+        fingerprint = true;
+        to_remove.insert(i);
       } else if (!strcmp(argv[i], "-h") || !strcmp(argv[i], "--help")) {
         help = true;
       }
     }
-    if (!help) utils::check_compatibility(dy_fsc_hypo, acp_param);
+
+    // Build all variants, grouped by mixing parametrisation so that the shared PDFs are built in one go.
+    // A single incompatible configuration is an error, while incompatible elements of a product of lists are skipped.
+    const bool single_variant = dy_fsc_hypos.size() * acp_params.size() * mix_params.size() == 1;
+    std::vector<Variant> variants;
+    for (const auto mix_param : mix_params) {
+      for (const auto dy_fsc_hypo : dy_fsc_hypos) {
+        for (const auto acp_param : acp_params) {
+          if (!help) {
+            try {
+              utils::check_compatibility(dy_fsc_hypo, acp_param);
+            } catch (const std::runtime_error&) {
+              if (single_variant) throw;
+              std::cout << "INFO Skipping incompatible configuration: " << dy_fsc_hypo << ", " << acp_param
+                        << std::endl;
+              continue;
+            }
+          }
+          variants.push_back({dy_fsc_hypo, acp_param, mix_param});
+        }
+      }
+    }
+    if (variants.empty())
+      throw std::runtime_error("main ERROR None of the requested configurations of the combination is viable");
+    if (help) variants.resize(1);  // the help message only needs to be printed once
 
     // Prepare the arguments to pass to GammaComboEngine
     std::vector<const char*> extra_args;
@@ -160,7 +275,289 @@ namespace {
     }
     for (auto arg : extra_args) combiner_argv.emplace_back(const_cast<char*>(arg));
 
-    return {dy_fsc_hypo, acp_param, mix_param, dcs_cpv, help, std::move(combiner_argv)};
+    return {std::move(variants), dcs_cpv, fingerprint, help, std::move(combiner_argv)};
+  }
+
+#ifdef CHARM_FITTER_WITH_BLUE
+  /**
+   * World average of DeltaY(h- h+) in 2021, solved by BLUE from the estimates of BLUE/src/DY.cpp: a single average
+   * (combination 106), or the K+ K- and pi+ pi- averages with their correlation (combination 111) if DeltaY depends on
+   * the final state.
+   */
+  PDF_BLUE* make_dy_blue(const hypotheses::dy_fsc dy_fsc_hypo, const parametrisations::acp acp_param,
+                         const parametrisations::mix mix_param) {
+    const auto parameters = utils::dy_hh_parameters_names(dy_fsc_hypo, acp_param, mix_param, {"KK", "PP"});
+    if (dy_fsc_hypo == hypotheses::dy_fsc::none) {
+      return new PDF_BLUE("DY_WA2021", BLUE::dy::inputs(), 106, 1e-4,
+                          {{"DY", "DY", "#Delta#it{Y}", utils::dy_hh_expression(dy_fsc_hypo, acp_param, mix_param)}},
+                          parameters);
+    }
+    return new PDF_BLUE(
+        "DY_WA2021", BLUE::dy::inputs(), 111, 1e-4,
+        {{"DY(KK)", "DY_KK", "#Delta#it{Y}_{#it{K}^{+}#it{K}^{#minus}}",
+          utils::dy_hh_expression(dy_fsc_hypo, acp_param, mix_param, "KK")},
+         {"DY(PP)", "DY_PP", "#Delta#it{Y}_{#it{#pi}^{+}#it{#pi}^{#minus}}",
+          utils::dy_hh_expression(dy_fsc_hypo, acp_param, mix_param, "PP")}},
+        parameters);
+  }
+
+  /**
+   * Check that the average of DeltaY(h- h+) solved by BLUE (PDF 74) agrees with the values copied by hand into PDF 72,
+   * within the rounding of the latter: the central values and uncertainties to 0.01e-4, and the correlation to 0.02.
+   */
+  void check_dy_blue(GammaComboEngine& gc) {
+    const auto hand = dynamic_cast<const PDF_Charm*>(gc.getPdf(72));
+    const auto blue = dynamic_cast<const PDF_Charm*>(gc.getPdf(74));
+    const auto fail = [](const std::string& what) {
+      throw std::runtime_error(std::format(
+          "check_dy_blue ERROR The BLUE average of DeltaY (PDF 74) differs from the values of PDF 72: {}", what));
+    };
+    if (!hand || !blue) fail("missing PDF");
+    const auto& obs_hand = hand->measuredObservables();
+    const auto& obs_blue = blue->measuredObservables();
+    if (obs_hand.getSize() != obs_blue.getSize()) fail("different number of observables");
+    // The observables of PDF 74 are in the order of the BLUE combination, which may differ from that of PDF 72. They
+    // are matched by the part of their names before "_obs", in case the engine appended an id to the names.
+    const auto base_name = [](const RooAbsArg* obs) {
+      const std::string name = obs->GetName();
+      return name.substr(0, name.find("_obs"));
+    };
+    std::vector<int> index;
+    for (const auto obs : obs_hand) {
+      const auto it = std::ranges::find_if(obs_blue, [&](const RooAbsArg* other) {
+        return base_name(other) == base_name(obs);
+      });
+      if (it == obs_blue.end()) fail(std::format("no observable {}", base_name(obs)));
+      index.push_back(static_cast<int>(std::distance(obs_blue.begin(), it)));
+    }
+    const auto& cov_hand = hand->covariance();
+    const auto& cov_blue = blue->covariance();
+    for (int i = 0; i < obs_hand.getSize(); ++i) {
+      const auto name = base_name(obs_hand.at(i));
+      const auto value_hand = static_cast<const RooRealVar*>(obs_hand.at(i))->getVal();
+      const auto value_blue = static_cast<const RooRealVar*>(obs_blue.at(index[i]))->getVal();
+      if (std::abs(value_hand - value_blue) > 0.01e-4) fail(std::format("{} = {} vs {}", name, value_blue, value_hand));
+      const auto err_hand = std::sqrt(cov_hand(i, i));
+      const auto err_blue = std::sqrt(cov_blue(index[i], index[i]));
+      if (std::abs(err_hand - err_blue) > 0.01e-4) fail(std::format("sigma({}) = {} vs {}", name, err_blue, err_hand));
+      for (int j = 0; j < i; ++j) {
+        const auto rho_hand = cov_hand(i, j) / err_hand / std::sqrt(cov_hand(j, j));
+        const auto rho_blue = cov_blue(index[i], index[j]) / err_blue / std::sqrt(cov_blue(index[j], index[j]));
+        if (std::abs(rho_hand - rho_blue) > 0.02) {
+          fail(std::format("rho({}, {}) = {} vs {}", name, base_name(obs_hand.at(j)), rho_blue, rho_hand));
+        }
+      }
+    }
+  }
+#endif
+
+  /**
+   * Cache of the PDFs that depend neither on the final-state correction to DeltaY(h- h+) nor on the aCP(h- h+)
+   * parametrisation. When several variants of the combination are run in the same process, these PDFs, with their
+   * measurement inputs, are only built once per mixing parametrisation and then added to the GammaComboEngine of each
+   * variant.
+   *
+   * GammaComboEngine::addPdf sets the id and title of the PDF, which are the same in every engine, and the combiners
+   * import a copy of the PDF into their own workspace, so the engines do not see each other. The subset PDFs are not
+   * cached, since GammaComboEngine::addSubsetPdf removes observables from the PDF. The cache owns the PDFs, which
+   * therefore outlive the engines they are added to.
+   */
+  class SharedPdfs {
+   public:
+    /// Return the PDF with the given id for the given mixing parametrisation, building it with `make_pdf` if needed.
+    template <typename Factory>
+    PDF_Abs* get(const mix mix_param, const int id, Factory&& make_pdf) {
+      auto [it, inserted] = pdfs.try_emplace({mix_param, id}, nullptr);
+      if (inserted) it->second = make_pdf();
+      return it->second;
+    }
+
+   private:
+    std::map<std::pair<mix, int>, PDF_Abs*> pdfs;
+  };
+
+  /**
+   * Add all PDFs to the engine, taking those that do not depend on the variant from `shared`. The PDF_DY,
+   * PDF_AcpHH_LHCb_Run12 and appB PDF_WS instances, and the subset PDFs, are built for each engine.
+   */
+  void add_pdfs(GammaComboEngine& gc, const Variant& variant, SharedPdfs& shared) {
+    const auto dy_fsc_hypo = variant.dy_fsc_hypo;
+    const auto acp_param = variant.acp_param;
+    const auto mix_param = variant.mix_param;
+    using parametrisations::kpi;
+
+    const auto add = [&](const int id, auto make_pdf, const char* title) {
+      gc.addPdf(id, shared.get(mix_param, id, make_pdf), title);
+    };
+
+    // clang-format off
+    add(1, [&] { return new PDF_XY("BaBar_Kshh", mix_param); },                           "XY KShh      BaBar                          ");
+    add(2, [&] { return new PDF_XY("BaBar_pipipi0", mix_param); },                        "XY pipipi0   BaBar                          ");
+    add(3, [&] { return new PDF_XY("LHCb_KSpipi", mix_param); },                          "XY KSpipi    LHCb     2011     [D* -> D0 pi]");
+    add(4, [&] { return new PDF_Kpipi0("BaBar", mix_param); },                            "Kpipi0       BaBar                          ");
+    add(5, [&] { return new PDF_K3pi("LHCb-run1", mix_param); },                          "K3pi         LHCb     Run 1                 ");
+    add(6, [&] { return new PDF_XY("Belle_Belle2", mix_param); },                         "XY KSpipi    Belle+Belle2 (951+408 fb-1)    ");
+
+    add(10, [&] { return new PDF_RM("HFLAV2016", mix_param); },                           "R_M          HFLAV    2016                  ");
+    add(11, [&] { return new PDF_RM("LHCb_K3pi_Run1", mix_param); },                      "R_M K3pi     LHCb                           ");
+
+    add(20, [&] { return new PDF_XY_QoP_PHI("Belle", mix_param); },                       "KShh         Belle                          ");
+    add(21, [&] { return new PDF_BinFlip("LHCb_Run1", mix_param); },                      "Bin-flip     LHCb     Run 1                 ");
+    add(22, [&] { return new PDF_BinFlip("LHCb_Run2_prompt", mix_param); },               "Bin-flip     LHCb     Run 2    [D* -> D0 pi]");
+    add(23, [&] { return new PDF_BinFlip("LHCb_Run2_sl", mix_param); },                   "Bin-flip     LHCb     Run 2    [B -> D0 mu] ");
+    add(24, [&] { return new PDF_BinFlip("LHCb_Run2", mix_param); },                      "Bin-flip     LHCb     Run 2                 ");
+
+    add(30, [&] { return new PDF_WS_NoCPV("CDF", mix_param); },                           "WS/RS        CDF                            ");
+    add(31, [&] { return new PDF_WS_NoCPV("BaBar", mix_param); },                         "WS/RS        BaBar    no CPV                ");
+    add(32, [&] { return new PDF_WS_NoCPV("Belle", mix_param); },                         "WS/RS        Belle    no CPV                ");
+    add(33, [&] { return new PDF_WS("BaBar", mix_param); },                               "WS/RS        BaBar                          ");
+    add(34, [&] { return new PDF_WS("Belle", mix_param); },                               "WS/RS        Belle                          ");
+    add(35, [&] { return new PDF_WS("LHCb_DT_Run1", mix_param); },                        "WS/RS        LHCb     Run 1    [B -> D* mu] ");
+    add(36, [&] { return new PDF_WS("LHCb_Run1", mix_param); },                           "WS/RS        LHCb     Run 1                 ");
+    add(37, [&] { return new PDF_WS("LHCb_Prompt_2011_2016", mix_param); },               "WS/RS        LHCb     2011-6   [D* -> D0 pi]");
+    add(38, [&] { return new PDF_WS("LHCb_Prompt_Run12_sec9", mix_param, kpi::ccprime); }, "WS/RS        LHCb     Run 1+2  [D* -> D0 pi]");
+    gc.addPdf(39, new PDF_WS("LHCb_Prompt_Run12_appB", mix_param, kpi::ccprime, dy_fsc_hypo, acp_param), "WS/RS        LHCb     Run 1+2  [D* -> D0 pi]");
+    add(40, [&] { return new PDF_WS("LHCb_DT_Run2", mix_param); },                        "WS/RS        LHCb     Run 2    [B -> D* mu] ");
+    add(41, [&] { return new PDF_WS("LHCb_DT_Run12", mix_param); },                       "WS/RS        LHCb     Run 1-2  [B -> D* mu] ");
+
+    add(50, [&] { return new PDF_CLEO_Kpi("Cleo-c", mix_param); },                        "Delta_Kpi    Cleo-c                         ");
+    add(51, [&] { return new PDF_BES_Kpi(mix_param); },                                   "Delta_Kpi    BES      3fb      [A_kpi only] ");
+    gc.addSubsetPdf(52, new PDF_BES_Kpi_pipipi0("3fb", mix_param), 0, 1, 2, 3,           "Kpi+pipipi0  BES      3fb                   ");
+    add(53, [&] { return new PDF_Fp_pipipi0("Cleo-c"); },                                 "Fpipipi0     Cleo-c                         ");
+    add(54, [&] { return new PDF_BES_CLEO_K3pi_Kpipi0("BES3-CLEO"); },                    "K3pi-Kpipi0  BES3 + Cleo                    ");
+    add(55, [&] { return new PDF_Fp_pipipi0("BESIII"); },                                 "Fpipipi0     BES3                           ");
+    add(56, [&] { return new PDF_BES_Kpi_pipipi0("3+7fb", mix_param); },                  "Kpi+pipipi0  BES3     3+7fb                 ");
+
+    add(60, [&] { return new PDF_yCP("WA-2015", mix_param); },                            "yCP          WA       2015                  ");
+    add(61, [&] { return new PDF_yCP_minus_yCP_RS("WA-2018", mix_param); },               "yCP-yCP(RS)  WA       2018                  ");
+    add(62, [&] { return new PDF_yCP_minus_yCP_KP("WA-2015", mix_param); },               "yCP-yCP(KP)  WA       2015                  ");
+    add(63, [&] { return new PDF_yCP_plus_yCP_RS("Belle", mix_param); },                  "yCP+yCP(RS)  Belle    2019                  ");
+    add(64, [&] { return new PDF_yCP_minus_yCP_RS("LHCb-R2", mix_param); },               "yCP-yCP(RS)  LHCb     2022                  ");
+
+    if (dy_fsc_hypo == dy_fsc::none) {
+      gc.addPdf(70, new PDF_DY("WA2019", dy_fsc_hypo, acp_param, mix_param),             "DY           WA       2019                  ");
+      gc.addPdf(73, new PDF_DY("Belle&BaBar", dy_fsc_hypo, acp_param, mix_param),        "DY           B-factories                    ");
+    }
+    gc.addPdf(71, new PDF_DY("WA2020", dy_fsc_hypo, acp_param, mix_param),               "DY           WA       2020                  ");
+    gc.addPdf(72, new PDF_DY("WA2021", dy_fsc_hypo, acp_param, mix_param),               "DY           WA       2021                  ");
+#ifdef CHARM_FITTER_WITH_BLUE
+    // Same as 72, but solved in-process by BLUE from the estimates of BLUE/src/DY.cpp. The combiners use it instead of
+    // 72 (see dy_wa2021), which check_dy_blue compares with it.
+    gc.addPdf(74, make_dy_blue(dy_fsc_hypo, acp_param, mix_param),                       "DY           WA       2021     [BLUE]       ");
+#endif
+
+    add(80, [&] { return new PDF_DY_RS("LHCb2021", mix_param); },                         "DY(RS)       LHCb     2021                  ");
+
+    if (dy_fsc_hypo == dy_fsc::none) {
+      add(85, [&] { return new PDF_DY_pipipi0("LHCb-R2", mix_param); },                   "DY(pipipi0)  LHCb     Run2                  ");
+    }
+
+    gc.addPdf(90, new PDF_AcpHH_LHCb_Run12(dy_fsc_hypo, acp_param, mix_param),                   "ACP(KK/PP)   LHCb     Run1+2                ");
+    gc.addSubsetPdf(93, new PDF_AcpHH_LHCb_Run12(dy_fsc_hypo, acp_param, mix_param), 0, 1, 4, 5, "ACP(KK/PP)   LHCb     Run1                  ");
+
+    add(100, [&] { return new PDF_scan_DY_RS(mix_param); },                               "ScanDYRS     This is just a nuisance parameter");
+
+    add(110, [&] { return new PDF_yCP("WA-biased-2019", mix_param); },                    "yCP          WA       2019     [biased]     ");
+    add(111, [&] { return new PDF_yCP("WA-biased-2022", mix_param); },                    "yCP-yCP(RS)  WA       2022     [biased]     ");
+    // clang-format on
+  }
+
+  /// Define all combiners. Some of them depend on the final-state correction to DeltaY(h- h+).
+  void define_combiners(GammaComboEngine& gc, const dy_fsc dy_fsc_hypo) {
+    gc.newCombiner(0, "empty", "empty");
+
+    // WA 2020
+    gc.newCombiner(1, "WA-2020", "World average (Dec 2020)", 1, 2, 3, 4, 10, 11, 20, 21, 30, 31, 32, 35, 37, 50, 51);
+    gc.getCombiner(1)->addPdf(gc[60]);
+    gc.getCombiner(1)->addPdf(gc[61]);
+    gc.getCombiner(1)->addPdf(gc[62]);
+    gc.getCombiner(1)->addPdf(gc[63]);
+    gc.getCombiner(1)->addPdf(gc[71]);
+
+    // WA June 2021
+    gc.cloneCombiner(20, 1, "WA-2021", "World average (June 2021)");
+    gc.getCombiner(20)->addPdf(gc[22]);  // bin-flip run 2
+    gc.getCombiner(20)->delPdf(gc[71]);  // DY WA 2020
+    gc.getCombiner(20)->addPdf(gc[dy_wa2021]);  // DY WA 2021
+    gc.getCombiner(20)->delPdf(gc[11]);  // LHCb K3pi (x2 + y2)/4
+    gc.getCombiner(20)->addPdf(gc[5]);   // LHCb K3pi full
+    gc.getCombiner(20)->addPdf(gc[54]);  // BES3 + CLEO K3pi, Kpipi0
+
+    // WA after LHCb 2022 yCP measurement
+    gc.cloneCombiner(30, 20, "WA-2022-02", "World average (Feb 2022)");
+    gc.getCombiner(30)->addPdf(gc[64]);  // yCP LHCb 2022
+
+    // WA after LHCb 2022 yCP measurement - biased
+    gc.cloneCombiner(31, 30, "WA-2022-02-biased",
+                     "World average (Feb 2022) #minus no #it{y}_{#it{CP}}^{#it{K^{#minus}#pi^{+}}} correction");
+    gc.getCombiner(31)->delPdf(gc[60]);
+    gc.getCombiner(31)->delPdf(gc[61]);
+    gc.getCombiner(31)->delPdf(gc[62]);
+    gc.getCombiner(31)->delPdf(gc[63]);
+    gc.getCombiner(31)->delPdf(gc[64]);
+    gc.getCombiner(31)->addPdf(gc[111]);
+
+    // WA September 2022
+    gc.cloneCombiner(40, 30, "WA-2022-09", "World average (Sept 2022)");
+    gc.getCombiner(40)->delPdf(gc[51]);  // old BESIII measurement of delta_Kpi
+    gc.getCombiner(40)->addPdf(gc[52]);  // new BESIII measurement of delta_Kpi
+    gc.getCombiner(40)->addPdf(gc[53]);  // F+_pipipi0
+    gc.getCombiner(40)->delPdf(gc[22]);  // bin-flip LHCb Run 2 prompt
+    gc.getCombiner(40)->addPdf(gc[24]);  // bin-flip LHCb Run 2
+    gc.getCombiner(40)->addPdf(gc[90]);  // ACP(KK) + DeltaACP LHCb Run 1+2
+
+    // WA March 2024 March before WS/RS
+    gc.cloneCombiner(49, 40, "WA-2024-02", "World average (Feb 2024)");
+    if (dy_fsc_hypo == dy_fsc::none) gc.getCombiner(49)->addPdf(gc[85]);  // DY(pi+ pi- pi0) from LHCb Run 2
+
+    // WA March 2024 - no FSC
+    gc.cloneCombiner(50, 40, "WA-2024-03", "World average (March 2024)");
+    gc.getCombiner(50)->delPdf(gc[37]);                                   // WS/RS in D0 -> Kpi from LHCb 2011-2016
+    gc.getCombiner(50)->addPdf(gc[39]);                                   // WS/RS in D0 -> Kpi from LHCb Run 1+2
+    if (dy_fsc_hypo == dy_fsc::none) gc.getCombiner(50)->addPdf(gc[85]);  // DY(pi+ pi- pi0) from LHCb Run 2
+
+    // WA March 2024 with parametrisation of prompt LHCb WS/RS decays from Sec. 9 - no FSC
+    gc.cloneCombiner(51, 50, "WA-2024-03-WSsec9", "World average (March 2024, prompt WS/RS from Sec. 9)");
+    gc.getCombiner(51)->delPdf(gc[39]);  // WS/RS in D0 -> Kpi from LHCb Run 1+2
+    gc.getCombiner(51)->addPdf(gc[38]);  // WS/RS in D0 -> Kpi from LHCb Run 1+2
+
+    // WA Sept 2024 (new BESIII F+(pi+pi-pi0))
+    gc.cloneCombiner(53, 50, "WA-2024-09", "World average (Sep 2024)");
+    gc.getCombiner(53)->addPdf(gc[55]);  // BESIII measurement of Fp_pipipi0
+
+    // WA October 2024 (new WS/RS with DT Run 2 data)
+    gc.cloneCombiner(54, 53, "WA-2024-10", "World average (October 2024)");
+    gc.getCombiner(54)->delPdf(gc[35]);  // WS/RS in D0 -> Kpi from LHCb Run 1 DT
+    gc.getCombiner(54)->addPdf(gc[41]);  // WS/RS in D0 -> Kpi from LHCb Run 1+2 DT
+
+    // WA October 2025 (new BinFlip from Belle + Belle 2, new BESIII Delta_Kpi, no new LHCb D0 -> K3pi Run 2) ------------
+    gc.cloneCombiner(55, 54, "WA-2025-10", "World average (October 2025)");
+    gc.getCombiner(55)->delPdf(gc[20]);  // D0 -> KS hh from Belle
+    gc.getCombiner(55)->addPdf(gc[6]);   // D0 -> KS pi pi BinFlip Belle + Belle 2
+    gc.getCombiner(55)->delPdf(gc[52]);  // D0 -> Kpi BESIII 3   fb
+    gc.getCombiner(55)->addPdf(gc[56]);  // D0 -> Kpi BESIII 3+7 fb
+
+    // LHCb-only averages ------------------------------------------------------------------------------------------------
+
+    gc.newCombiner(300, "LHCb-2024-05", "LHCb average (May 2024)");
+    for (const auto imeas : get_lhcb_pdfs("run12", dy_fsc_hypo)) gc.getCombiner(300)->addPdf(gc[imeas]);
+
+    // LHCb-only + charm factories averages ------------------------------------------------------------------------------
+
+    gc.cloneCombiner(400, 300, "LHCb-CF-2024-05", "LHCb + Charm factories average (May 2024)");
+    for (auto imeas : {50, 52, 53}) gc.getCombiner(400)->addPdf(gc[imeas]);
+
+    // Impact of LHCb upgrades -------------------------------------------------------------------------------------------
+
+    // WA before LHCb Run 2
+    if (dy_fsc_hypo == dy_fsc::none) {
+      gc.newCombiner(500, "LHCb-Run1", "World average before LHCb Run 2");
+      for (auto imeas : {1, 2, 3, 4, 10, 11, 20, 21, 30, 31, 32, 35, 36, 50, 52, 60, 61, 62, 63, 70, 93})
+        gc.getCombiner(500)->addPdf(gc[imeas]);
+    }
+
+    // WA after LHCb Run 2
+    gc.cloneCombiner(501, 50, "LHCb-Run2", "World average after LHCb Run 2");
   }
 }  // namespace
 
@@ -178,215 +575,87 @@ namespace {
  *   --dcs-cpv Do allow for CP violation in doubly Cabibbo-suppressed D0 -> K+ pi- decays.
  *       It changes the combiner name to `<combiner_name>_dcs-cpv`. If not set, the argument `--fix Acp_KP=0` is
  *       automatically passed to GammaComboEngine.
+ *   --derived <name>[=<expression>] Scan a quantity derived from the parameters instead of running the combination
+ *       (see Impact.h). DY_RS, the absolute value of DeltaY(K- pi+), is predefined.
+ *   --fingerprint Print the inputs of all PDFs and combiners (see ScanCache.h) instead of running the combination.
+ *   --impact Refit the selected combiners with each PDF removed instead of running the combination (see Impact.h).
+ *   --impact-add <pdf>[,<pdf>...] With `--impact`, also refit the selected combiners with each of these PDFs added.
+ *   --multistart <n> Save the minima found by fitting the selected combiners from n start points instead of running
+ *       the combination (see Impact.h).
+ *   --multistart-seed <n> Seed of the start points of --multistart (default: 1).
+ *   --preview Write the Gaussian approximation of the selected scan instead of running the combination (see Impact.h).
+ *   --project <file> Project the uncertainties of the selected combiners to the scenarios in <file> instead of running
+ *       the combination (see Impact.h).
+ *   --save-nuisances Save the parameters at each point of the scan grid (see ScanColumns.h).
+ *
+ * The options `--dy-fsc`, `--acp` and `--mix` accept comma-separated lists of values. In this case all compatible
+ * variants are run in sequence within the same process, each with its own GammaComboEngine (and hence its own
+ * combiner name and output files), while the PDFs that do not depend on the variant are built only once per mixing
+ * parametrisation.
+ *
+ * The scanner files written by each variant are also copied to a columnar format under plots/columns/ (see
+ * ScanColumns.h).
  *
  * Passing "-h" or "--help" prints the options above, followed by the full list of GammaCombo options.
  */
 int main(int argc, char* argv[]) {
+  const auto columns_options = scan_columns::parse_options(argc, argv);
+  const bool impact_mode = io::parse_flag(argc, argv, "--impact");
+  const auto impact_add = io::parse_option(argc, argv, "--impact-add");
+  const auto project_file = io::parse_last_option(argc, argv, "--project");
+  const bool preview_mode = io::parse_flag(argc, argv, "--preview");
+  const auto num_starts = io::parse_last_option(argc, argv, "--multistart");
+  const auto seed = io::parse_last_option(argc, argv, "--multistart-seed");
+  const auto derived = io::parse_option(argc, argv, "--derived");
   auto parsed_args = parse_args(argc, argv);
-  const auto dy_fsc_hypo = parsed_args.dy_fsc_hypo;
-  const auto acp_param = parsed_args.acp_param;
-  const auto mix_param = parsed_args.mix_param;
   const bool dcs_cpv = parsed_args.dcs_cpv;
   std::vector<char*> combiner_argv = std::move(parsed_args.combiner_argv);
 
-  if (parsed_args.help) {
-    print_charm_help();
-  } else {
-    std::cout << "INFO The combination will be run with the following configuration:\n"
-              << "     DeltaY(h- h+) final-state correction: " << dy_fsc_hypo << "\n"
-              << "     aCP(h- h+) asymmetry parametrisation: " << acp_param << "\n"
-              << "     Mixing parametrisation: " << mix_param << "\n"
-              << "     Allow for CP violation in DCS D0 -> K+ pi- decays: " << dcs_cpv << std::endl;
-  }
-
-  std::string combiner_name = std::format("charm-combo_{}-dyfsc_{}_{}", utils::get_id(dy_fsc_hypo),
-                                          utils::get_id(acp_param), utils::get_id(mix_param));
-  if (dcs_cpv) { combiner_name += "_dcs-cpv"; }
-  GammaComboEngine gc(combiner_name, combiner_argv.size(), &combiner_argv[0]);
-
-  ///////////////////////////////////////////////////
-  //
-  // define PDFs
-  //
-  ///////////////////////////////////////////////////
-
-  using hypotheses::dy_fsc;
-  using parametrisations::kpi;
-
-  // clang-format off
-  gc.addPdf(1, new PDF_XY("BaBar_Kshh", mix_param),                                  "XY KShh      BaBar                          ");
-  gc.addPdf(2, new PDF_XY("BaBar_pipipi0", mix_param),                               "XY pipipi0   BaBar                          ");
-  gc.addPdf(3, new PDF_XY("LHCb_KSpipi", mix_param),                                 "XY KSpipi    LHCb     2011     [D* -> D0 pi]");
-  gc.addPdf(4, new PDF_Kpipi0("BaBar", mix_param),                                   "Kpipi0       BaBar                          ");
-  gc.addPdf(5, new PDF_K3pi("LHCb-run1", mix_param),                                 "K3pi         LHCb     Run 1                 ");
-  gc.addPdf(6, new PDF_XY("Belle_Belle2", mix_param),                                "XY KSpipi    Belle+Belle2 (951+408 fb-1)    ");
-
-  gc.addPdf(10, new PDF_RM("HFLAV2016", mix_param),                                  "R_M          HFLAV    2016                  ");
-  gc.addPdf(11, new PDF_RM("LHCb_K3pi_Run1", mix_param),                             "R_M K3pi     LHCb                           ");
-
-  gc.addPdf(20, new PDF_XY_QoP_PHI("Belle", mix_param),                              "KShh         Belle                          ");
-  gc.addPdf(21, new PDF_BinFlip("LHCb_Run1", mix_param),                             "Bin-flip     LHCb     Run 1                 ");
-  gc.addPdf(22, new PDF_BinFlip("LHCb_Run2_prompt", mix_param),                      "Bin-flip     LHCb     Run 2    [D* -> D0 pi]");
-  gc.addPdf(23, new PDF_BinFlip("LHCb_Run2_sl", mix_param),                          "Bin-flip     LHCb     Run 2    [B -> D0 mu] ");
-  gc.addPdf(24, new PDF_BinFlip("LHCb_Run2", mix_param),                             "Bin-flip     LHCb     Run 2                 ");
-
-  gc.addPdf(30, new PDF_WS_NoCPV("CDF", mix_param),                                  "WS/RS        CDF                            ");
-  gc.addPdf(31, new PDF_WS_NoCPV("BaBar", mix_param),                                "WS/RS        BaBar    no CPV                ");
-  gc.addPdf(32, new PDF_WS_NoCPV("Belle", mix_param),                                "WS/RS        Belle    no CPV                ");
-  gc.addPdf(33, new PDF_WS("BaBar", mix_param),                                      "WS/RS        BaBar                          ");
-  gc.addPdf(34, new PDF_WS("Belle", mix_param),                                      "WS/RS        Belle                          ");
-  gc.addPdf(35, new PDF_WS("LHCb_DT_Run1", mix_param),                               "WS/RS        LHCb     Run 1    [B -> D* mu] ");
-  gc.addPdf(36, new PDF_WS("LHCb_Run1", mix_param),                                  "WS/RS        LHCb     Run 1                 ");
-  gc.addPdf(37, new PDF_WS("LHCb_Prompt_2011_2016", mix_param),                      "WS/RS        LHCb     2011-6   [D* -> D0 pi]");
-  gc.addPdf(38, new PDF_WS("LHCb_Prompt_Run12_sec9", mix_param, kpi::ccprime),       "WS/RS        LHCb     Run 1+2  [D* -> D0 pi]");
-  gc.addPdf(39, new PDF_WS("LHCb_Prompt_Run12_appB", mix_param, kpi::ccprime, dy_fsc_hypo, acp_param), "WS/RS        LHCb     Run 1+2  [D* -> D0 pi]");
-  gc.addPdf(40, new PDF_WS("LHCb_DT_Run2", mix_param),                               "WS/RS        LHCb     Run 2    [B -> D* mu] ");
-  gc.addPdf(41, new PDF_WS("LHCb_DT_Run12", mix_param),                              "WS/RS        LHCb     Run 1-2  [B -> D* mu] ");
-
-  gc.addPdf(50, new PDF_CLEO_Kpi("Cleo-c", mix_param),                               "Delta_Kpi    Cleo-c                         ");
-  gc.addPdf(51, new PDF_BES_Kpi(mix_param),                                          "Delta_Kpi    BES      3fb      [A_kpi only] ");
-  gc.addSubsetPdf(52, new PDF_BES_Kpi_pipipi0("3fb", mix_param), 0, 1, 2, 3,         "Kpi+pipipi0  BES      3fb                   ");
-  gc.addPdf(53, new PDF_Fp_pipipi0("Cleo-c"),                                        "Fpipipi0     Cleo-c                         ");
-  gc.addPdf(54, new PDF_BES_CLEO_K3pi_Kpipi0("BES3-CLEO"),                           "K3pi-Kpipi0  BES3 + Cleo                    ");
-  gc.addPdf(55, new PDF_Fp_pipipi0("BESIII"),                                        "Fpipipi0     BES3                           ");
-  gc.addPdf(56, new PDF_BES_Kpi_pipipi0("3+7fb", mix_param),                         "Kpi+pipipi0  BES3     3+7fb                 ");
-
-  gc.addPdf(60, new PDF_yCP("WA-2015", mix_param),                                   "yCP          WA       2015                  ");
-  gc.addPdf(61, new PDF_yCP_minus_yCP_RS("WA-2018", mix_param),                      "yCP-yCP(RS)  WA       2018                  ");
-  gc.addPdf(62, new PDF_yCP_minus_yCP_KP("WA-2015", mix_param),                      "yCP-yCP(KP)  WA       2015                  ");
-  gc.addPdf(63, new PDF_yCP_plus_yCP_RS("Belle", mix_param),                         "yCP+yCP(RS)  Belle    2019                  ");
-  gc.addPdf(64, new PDF_yCP_minus_yCP_RS("LHCb-R2", mix_param),                      "yCP-yCP(RS)  LHCb     2022                  ");
-
-  if (dy_fsc_hypo == dy_fsc::none) {
-    gc.addPdf(70, new PDF_DY("WA2019", dy_fsc_hypo, acp_param, mix_param),           "DY           WA       2019                  ");
-    gc.addPdf(73, new PDF_DY("Belle&BaBar", dy_fsc_hypo, acp_param, mix_param),      "DY           B-factories                    ");
-  }
-  gc.addPdf(71, new PDF_DY("WA2020", dy_fsc_hypo, acp_param, mix_param),             "DY           WA       2020                  ");
-  gc.addPdf(72, new PDF_DY("WA2021", dy_fsc_hypo, acp_param, mix_param),             "DY           WA       2021                  ");
-
-  gc.addPdf(80, new PDF_DY_RS("LHCb2021", mix_param),                                "DY(RS)       LHCb     2021                  ");
-
-  if (dy_fsc_hypo == dy_fsc::none) {
-    gc.addPdf(85, new PDF_DY_pipipi0("LHCb-R2", mix_param),                          "DY(pipipi0)  LHCb     Run2                  ");
-  }
+  if (parsed_args.help) print_charm_help();
+
+  SharedPdfs shared_pdfs;
+  for (const auto& variant : parsed_args.variants) {
+    const auto [dy_fsc_hypo, acp_param, mix_param] = variant;
+    if (!parsed_args.help && !parsed_args.fingerprint) {
+      std::cout << "INFO The combination will be run with the following configuration:\n"
+                << "     DeltaY(h- h+) final-state correction: " << dy_fsc_hypo << "\n"
+                << "     aCP(h- h+) asymmetry parametrisation: " << acp_param << "\n"
+                << "     Mixing parametrisation: " << mix_param << "\n"
+                << "     Allow for CP violation in DCS D0 -> K+ pi- decays: " << dcs_cpv << std::endl;
+    }
 
-  gc.addPdf(90, new PDF_AcpHH_LHCb_Run12(dy_fsc_hypo, acp_param, mix_param),                   "ACP(KK/PP)   LHCb     Run1+2                ");
-  gc.addSubsetPdf(93, new PDF_AcpHH_LHCb_Run12(dy_fsc_hypo, acp_param, mix_param), 0, 1, 4, 5, "ACP(KK/PP)   LHCb     Run1                  ");
-
-  gc.addPdf(100, new PDF_scan_DY_RS(mix_param),                                      "ScanDYRS     This is just a nuisance parameter");
-
-  gc.addPdf(110, new PDF_yCP("WA-biased-2019", mix_param),                           "yCP          WA       2019     [biased]     ");
-  gc.addPdf(111, new PDF_yCP("WA-biased-2022", mix_param),                           "yCP-yCP(RS)  WA       2022     [biased]     ");
-  // clang-format on
-
-  ///////////////////////////////////////////////////
-  //
-  // Define combinations
-  //
-  ///////////////////////////////////////////////////
-
-  gc.newCombiner(0, "empty", "empty");
-
-  // WA 2020
-  gc.newCombiner(1, "WA-2020", "World average (Dec 2020)", 1, 2, 3, 4, 10, 11, 20, 21, 30, 31, 32, 35, 37, 50, 51);
-  gc.getCombiner(1)->addPdf(gc[60]);
-  gc.getCombiner(1)->addPdf(gc[61]);
-  gc.getCombiner(1)->addPdf(gc[62]);
-  gc.getCombiner(1)->addPdf(gc[63]);
-  gc.getCombiner(1)->addPdf(gc[71]);
-
-  // WA June 2021
-  gc.cloneCombiner(20, 1, "WA-2021", "World average (June 2021)");
-  gc.getCombiner(20)->addPdf(gc[22]);  // bin-flip run 2
-  gc.getCombiner(20)->delPdf(gc[71]);  // DY WA 2020
-  gc.getCombiner(20)->addPdf(gc[72]);  // DY WA 2021
-  gc.getCombiner(20)->delPdf(gc[11]);  // LHCb K3pi (x2 + y2)/4
-  gc.getCombiner(20)->addPdf(gc[5]);   // LHCb K3pi full
-  gc.getCombiner(20)->addPdf(gc[54]);  // BES3 + CLEO K3pi, Kpipi0
-
-  // WA after LHCb 2022 yCP measurement
-  gc.cloneCombiner(30, 20, "WA-2022-02", "World average (Feb 2022)");
-  gc.getCombiner(30)->addPdf(gc[64]);  // yCP LHCb 2022
-
-  // WA after LHCb 2022 yCP measurement - biased
-  gc.cloneCombiner(31, 30, "WA-2022-02-biased",
-                   "World average (Feb 2022) #minus no #it{y}_{#it{CP}}^{#it{K^{#minus}#pi^{+}}} correction");
-  gc.getCombiner(31)->delPdf(gc[60]);
-  gc.getCombiner(31)->delPdf(gc[61]);
-  gc.getCombiner(31)->delPdf(gc[62]);
-  gc.getCombiner(31)->delPdf(gc[63]);
-  gc.getCombiner(31)->delPdf(gc[64]);
-  gc.getCombiner(31)->addPdf(gc[111]);
-
-  // WA September 2022
-  gc.cloneCombiner(40, 30, "WA-2022-09", "World average (Sept 2022)");
-  gc.getCombiner(40)->delPdf(gc[51]);  // old BESIII measurement of delta_Kpi
-  gc.getCombiner(40)->addPdf(gc[52]);  // new BESIII measurement of delta_Kpi
-  gc.getCombiner(40)->addPdf(gc[53]);  // F+_pipipi0
-  gc.getCombiner(40)->delPdf(gc[22]);  // bin-flip LHCb Run 2 prompt
-  gc.getCombiner(40)->addPdf(gc[24]);  // bin-flip LHCb Run 2
-  gc.getCombiner(40)->addPdf(gc[90]);  // ACP(KK) + DeltaACP LHCb Run 1+2
-
-  // WA March 2024 March before WS/RS
-  gc.cloneCombiner(49, 40, "WA-2024-02", "World average (Feb 2024)");
-  if (dy_fsc_hypo == dy_fsc::none) gc.getCombiner(49)->addPdf(gc[85]);  // DY(pi+ pi- pi0) from LHCb Run 2
-
-  // WA March 2024 - no FSC
-  gc.cloneCombiner(50, 40, "WA-2024-03", "World average (March 2024)");
-  gc.getCombiner(50)->delPdf(gc[37]);                                   // WS/RS in D0 -> Kpi from LHCb 2011-2016
-  gc.getCombiner(50)->addPdf(gc[39]);                                   // WS/RS in D0 -> Kpi from LHCb Run 1+2
-  if (dy_fsc_hypo == dy_fsc::none) gc.getCombiner(50)->addPdf(gc[85]);  // DY(pi+ pi- pi0) from LHCb Run 2
-
-  // WA March 2024 with parametrisation of prompt LHCb WS/RS decays from Sec. 9 - no FSC
-  gc.cloneCombiner(51, 50, "WA-2024-03-WSsec9", "World average (March 2024, prompt WS/RS from Sec. 9)");
-  gc.getCombiner(51)->delPdf(gc[39]);  // WS/RS in D0 -> Kpi from LHCb Run 1+2
-  gc.getCombiner(51)->addPdf(gc[38]);  // WS/RS in D0 -> Kpi from LHCb Run 1+2
-
-  // WA Sept 2024 (new BESIII F+(pi+pi-pi0))
-  gc.cloneCombiner(53, 50, "WA-2024-09", "World average (Sep 2024)");
-  gc.getCombiner(53)->addPdf(gc[55]);  // BESIII measurement of Fp_pipipi0
-
-  // WA October 2024 (new WS/RS with DT Run 2 data)
-  gc.cloneCombiner(54, 53, "WA-2024-10", "World average (October 2024)");
-  gc.getCombiner(54)->delPdf(gc[35]);  // WS/RS in D0 -> Kpi from LHCb Run 1 DT
-  gc.getCombiner(54)->addPdf(gc[41]);  // WS/RS in D0 -> Kpi from LHCb Run 1+2 DT
-
-  // WA October 2025 (new BinFlip from Belle + Belle 2, new BESIII Delta_Kpi, no new LHCb D0 -> K3pi Run 2) ------------
-  gc.cloneCombiner(55, 54, "WA-2025-10", "World average (October 2025)");
-  gc.getCombiner(55)->delPdf(gc[20]);  // D0 -> KS hh from Belle
-  gc.getCombiner(55)->addPdf(gc[6]);   // D0 -> KS pi pi BinFlip Belle + Belle 2
-  gc.getCombiner(55)->delPdf(gc[52]);  // D0 -> Kpi BESIII 3   fb
-  gc.getCombiner(55)->addPdf(gc[56]);  // D0 -> Kpi BESIII 3+7 fb
-
-  // LHCb-only averages ------------------------------------------------------------------------------------------------
-
-  gc.newCombiner(300, "LHCb-2024-05", "LHCb average (May 2024)");
-  for (const auto imeas : get_lhcb_pdfs("run12", dy_fsc_hypo)) gc.getCombiner(300)->addPdf(gc[imeas]);
-
-  // LHCb-only + charm factories averages ------------------------------------------------------------------------------
-
-  gc.cloneCombiner(400, 300, "LHCb-CF-2024-05", "LHCb + Charm factories average (May 2024)");
-  for (auto imeas : {50, 52, 53}) gc.getCombiner(400)->addPdf(gc[imeas]);
-
-  // Impact of LHCb upgrades -------------------------------------------------------------------------------------------
-
-  // WA before LHCb Run 2
-  if (dy_fsc_hypo == dy_fsc::none) {
-    gc.newCombiner(500, "LHCb-Run1", "World average before LHCb Run 2");
-    for (auto imeas : {1, 2, 3, 4, 10, 11, 20, 21, 30, 31, 32, 35, 36, 50, 52, 60, 61, 62, 63, 70, 93})
-      gc.getCombiner(500)->addPdf(gc[imeas]);
+    std::string combiner_name = std::format("charm-combo_{}-dyfsc_{}_{}", utils::get_id(dy_fsc_hypo),
+                                            utils::get_id(acp_param), utils::get_id(mix_param));
+    if (dcs_cpv) { combiner_name += "_dcs-cpv"; }
+    GammaComboEngine gc(combiner_name, combiner_argv.size(), &combiner_argv[0]);
+
+    add_pdfs(gc, variant, shared_pdfs);
+#ifdef CHARM_FITTER_WITH_BLUE
+    check_dy_blue(gc);
+#endif
+    define_combiners(gc, dy_fsc_hypo);
+    if (parsed_args.fingerprint) {
+      scan_cache::print_fingerprints(gc, combiner_name);
+    } else if (!derived.empty() && !parsed_args.help) {
+      // The same quantity as the parameter DY_RS of PDF_scan_DY_RS (PDF 100), which GammaCombo can scan, too
+      const impact::PredefinedQuantity dy_rs{std::format("abs({})", utils::dy_kp_expression(mix_param)), 0.,
+                                             std::numeric_limits<double>::infinity()};
+      impact::scan_derived(gc, combiner_name, combiner_argv, derived, {{"DY_RS", dy_rs}});
+    } else if (impact_mode && !parsed_args.help) {
+      impact::run(gc, combiner_name, combiner_argv, impact_add);
+    } else if (num_starts && !parsed_args.help) {
+      impact::multistart(gc, combiner_name, combiner_argv, std::stoi(*num_starts),
+                         seed ? static_cast<unsigned>(std::stoul(*seed)) : 1u);
+    } else if (preview_mode && !parsed_args.help) {
+      impact::preview(gc, combiner_name, combiner_argv);
+    } else if (project_file && !parsed_args.help) {
+      impact::project(gc, combiner_name, combiner_argv, *project_file);
+    } else {
+      const auto start = std::filesystem::file_time_type::clock::now();
+      gc.run();
+      scan_columns::convert_new(gc, combiner_name, start, columns_options);
+    }
   }
 
-  // WA after LHCb Run 2
-  gc.cloneCombiner(501, 50, "LHCb-Run2", "World average after LHCb Run 2");
-
-  ///////////////////////////////////////////////////
-  //
-  // Run
-  //
-  ///////////////////////////////////////////////////
-
-  gc.run();
-
   return 0;
 }
@@ -10,9 +10,13 @@
 
 // CharmFitter
 #include <CharmUtils.h>
+#include <IoUtils.h>
 #include <PDF_WS.h>
 #include <PDF_WS_NoCPV.h>
+#include <ScanCache.h>
+#include <ScanColumns.h>
 
+#include <filesystem>
 #include <format>
 #include <stdexcept>
 #include <string>
@@ -20,8 +24,15 @@
 
 /**
  * Main function to combine WS/RS D0 -> K pi measurements using the (y', x'2) parametrisation.
+ *
+ * Accepts all command-line arguments of GammaComboEngine, and in addition `--fingerprint` to print the inputs of all
+ * PDFs and combiners (see ScanCache.h) instead of running the combination. The scanner files are also copied to a
+ * columnar format under plots/columns/, including the parameters at each scan point with `--save-nuisances` (see
+ * ScanColumns.h).
  */
 int main(int argc, char* argv[]) {
+  const bool fingerprint = io::parse_flag(argc, argv, "--fingerprint");
+  const auto columns_options = scan_columns::parse_options(argc, argv);
 
   GammaComboEngine gc("ws-combo", argc, &argv[0]);
 
@@ -56,7 +67,13 @@ int main(int argc, char* argv[]) {
   gc.newCombiner(20, "WA2025", "World average 2025", {0, 10, 11, 23, 25});
 
   // Run the combination
-  gc.run();
+  if (fingerprint) {
+    scan_cache::print_fingerprints(gc, "ws-combo");
+  } else {
+    const auto start = std::filesystem::file_time_type::clock::now();
+    gc.run();
+    scan_columns::convert_new(gc, "ws-combo", start, columns_options);
+  }
 
   return 0;
 }
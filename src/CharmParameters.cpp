@@ -8,15 +8,43 @@
 
 #include <Utils.h>
 
+#include <cmath>
+#include <format>
+#include <set>
+#include <stdexcept>
+#include <string>
+
 using Utils::DegToRad;
 
+namespace {
+  /// Names of the parameters flagged as periodic by CharmParameters::setPeriodic.
+  std::set<std::string> periodic_names;
+}  // namespace
+
 CharmParameters::CharmParameters() { defineParameters(); }
 
+double CharmParameters::period(const RooRealVar& var) {
+  return periodic_names.contains(var.GetName()) ? var.getMax() - var.getMin() : 0.;
+}
+
+void CharmParameters::setPeriodic(const Parameter* p) {
+  if (std::abs(p->phys.max - p->phys.min - DegToRad(360.)) > 1e-9) {
+    throw std::runtime_error(std::format(
+        "CharmParameters::setPeriodic ERROR The physical range of the periodic parameter {} is not a full turn",
+        p->name.Data()));
+  }
+  periodic_names.insert(p->name.Data());
+}
+
 /**
  * Define all (nuisance) parameters.
  *
  * scan:  Defines the scan range (for Prob and Plugin methods)
  * phys:  Defines the physically allowed range (needs to be set!)
+ *
+ * The weak phases and the strong phases of D0 -> h+ h-, which enter all PDFs through their sine and cosine, are flagged
+ * with setPeriodic. The strong-phase differences Delta_Kpi, Delta_K3pi and Delta_Kpipi0 are not, since some of their
+ * inputs measure them linearly within their range (e.g. PDF_BES_CLEO_K3pi_Kpipi0).
  */
 void CharmParameters::defineParameters() {
   Parameter* p = nullptr;
@@ -63,6 +91,7 @@ void CharmParameters::defineParameters() {
   p->unit = "";
   p->scan = range(DegToRad(-180), DegToRad(180));
   p->phys = range(DegToRad(-180), DegToRad(180));
+  setPeriodic(p);
 
   p = newParameter("cot_delta_KK");
   p->title = "cot(#it{#delta_{#it{K^{+}K^{#minus}}}})";
@@ -104,6 +133,7 @@ void CharmParameters::defineParameters() {
   p->unit = "";
   p->scan = range(DegToRad(-180), DegToRad(180));
   p->phys = range(DegToRad(-180), DegToRad(180));
+  setPeriodic(p);
 
   p = newParameter("cot_delta_PP");
   p->title = "cot(#it{#delta_{#it{#pi^{+}#pi^{#minus}}}})";
@@ -257,6 +287,7 @@ void CharmParameters::defineParameters() {
   p->unit = "";
   p->scan = range(-0.6, 0.6);
   p->phys = range(DegToRad(-180.), DegToRad(180.));
+  setPeriodic(p);
 
   // Theoretical parametrisation
 
@@ -280,6 +311,7 @@ void CharmParameters::defineParameters() {
   p->unit = "";
   p->scan = range(-0.5, 0.5);
   p->phys = range(-1.5, -1.5 + DegToRad(360.));
+  setPeriodic(p);
 
   p = newParameter("phiG");
   p->title = "#it{#phi}^{#Gamma}_{2} [rad]";
@@ -287,6 +319,7 @@ void CharmParameters::defineParameters() {
   p->unit = "";
   p->scan = range(-0.3, 0.3);
   p->phys = range(DegToRad(-180.), DegToRad(180.));
+  setPeriodic(p);
 
   // Parameters for the (D0 -> K pi)-only combination ------------------------------------------------------------------
 
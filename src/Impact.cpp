@@ -0,0 +1,1124 @@
+#include <Impact.h>
+
+#include <CharmParameters.h>
+#include <IoUtils.h>
+#include <NuisanceProfiler.h>
+#include <PDF_Charm.h>
+#include <ScanColumns.h>
+
+#include <GammaComboEngine.h>
+
+#include <RooAbsReal.h>
+#include <RooRealVar.h>
+
+#include <TFile.h>
+#include <TH1.h>
+#include <TH2.h>
+#include <TMatrixD.h>
+#include <TMatrixDSym.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+  const fs::path impact_dir = "plots/impact";
+  const fs::path projection_dir = "plots/projection";
+  const fs::path preview_dir = "plots/preview";
+  const fs::path multistart_dir = "plots/multistart";
+  const fs::path scanner_dir = "plots/scanner";
+  const fs::path par_dir = "plots/par";
+  /// Source of the previews in their outputs, to tell them apart from the scans.
+  const std::string approximation = "Gaussian approximation (HESSE at the global minimum of the combiner)";
+
+  /// `str` as an int or a double, all of it, or else throw `error`, which names the token being parsed.
+  template <typename T>
+  T parse_number(const std::string& str, const std::runtime_error& error) {
+    std::size_t pos = 0;
+    T value;
+    try {
+      if constexpr (std::is_same_v<T, int>)
+        value = std::stoi(str, &pos);
+      else
+        value = std::stod(str, &pos);
+    } catch (const std::logic_error&) { throw error; }  // std::invalid_argument or std::out_of_range
+    if (pos != str.size()) throw error;
+    return value;
+  }
+
+  /// Result of a fit: value and uncertainty of each parameter, chi2 and Minuit2 status.
+  struct Fit {
+    std::map<std::string, std::pair<double, double>> pars;
+    double chi2;
+    int status;
+  };
+
+  /**
+   * Fit the chi2 of a combiner, with the `floating` parameters free and those in `fixed` set to the given values.
+   *
+   * @param start Fit where the minimisation starts from, with its uncertainties as step sizes.
+   */
+  Fit fit(Combiner& combiner, const std::vector<std::string>& floating, const std::map<std::string, double>& fixed,
+          const Fit* start) {
+    NuisanceProfiler profiler(combiner, floating, {});
+    for (const auto& [name, value] : fixed) profiler.setValue(name, value);
+    if (start) {
+      for (const auto& [name, par] : start->pars) profiler.setValue(name, par.first, par.second);
+    }
+    const auto result = profiler.fit({}, {}, true);
+
+    Fit f{{}, result.chi2, result.status};
+    for (std::size_t i = 0; i < result.values.size(); ++i) {
+      f.pars[profiler.parameters()[i]] = {result.values[i], result.errors[i]};
+    }
+    return f;
+  }
+
+  /// Write a fit as text, one parameter per line, to pass it from a child process.
+  std::string serialise(const Fit& f) {
+    auto out = std::format("{:.17g} {}\n", f.chi2, f.status);
+    for (const auto& [name, par] : f.pars) out += std::format("{} {:.17g} {:.17g}\n", name, par.first, par.second);
+    return out;
+  }
+
+  Fit deserialise(const std::string& str) {
+    std::istringstream in(str);
+    Fit f{{}, 0., 0};
+    in >> f.chi2 >> f.status;
+    std::string name;
+    double value, error;
+    while (in >> name >> value >> error) f.pars[name] = {value, error};
+    return f;
+  }
+
+  /**
+   * Run `task(i)` for i = 0, ..., n - 1, each in a forked process, with at most `num_procs` processes at a time, and
+   * return the text written by each task. The PDFs share their parameters, so their fits cannot run in threads of the
+   * same process.
+   */
+  std::vector<std::string> run_forked(const std::size_t n, const unsigned num_procs,
+                                      const std::function<std::string(std::size_t)>& task) {
+    struct Child {
+      pid_t pid;
+      int fd;
+      std::size_t task;
+    };
+
+    std::vector<std::string> outputs(n);
+    std::vector<Child> running;
+    std::vector<std::size_t> failed;
+    // Read the output of a child until it closes its pipe, then reap it
+    const auto finish = [&outputs, &failed](const Child& child) {
+      char buffer[4096];
+      for (ssize_t len; (len = read(child.fd, buffer, sizeof(buffer))) != 0;) {
+        if (len < 0 && errno == EINTR) continue;
+        if (len < 0) break;
+        outputs[child.task].append(buffer, len);
+      }
+      close(child.fd);
+      int status = 0;
+      while (waitpid(child.pid, &status, 0) < 0 && errno == EINTR) {}
+      if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) failed.push_back(child.task);
+    };
+    // Kill and reap the running children before throwing, so that none is left behind
+    const auto stop = [&running, &failed](const std::string& error) {
+      for (const auto& child : running) kill(child.pid, SIGKILL);
+      for (const auto& child : running) {
+        close(child.fd);
+        while (waitpid(child.pid, nullptr, 0) < 0 && errno == EINTR) {}
+      }
+      running.clear();
+      std::string tasks;
+      for (const auto task : failed) tasks += (tasks.empty() ? "" : ", ") + std::to_string(task);
+      throw std::runtime_error(std::format("impact::run_forked ERROR {}{}", error,
+                                           failed.empty() ? "" : std::format(" (failed tasks: {})", tasks)));
+    };
+
+    for (std::size_t next = 0; next < n || !running.empty();) {
+      if (!failed.empty()) stop("Stopped after a task failed");
+      if (next == n || running.size() == num_procs) {
+        // The oldest child is drained first, the others may block on a full pipe until their turn
+        const auto child = running.front();
+        running.erase(running.begin());
+        finish(child);
+        continue;
+      }
+      int fds[2];
+      if (pipe(fds) != 0) stop("Cannot create a pipe");
+      std::cout.flush();
+      std::fflush(nullptr);
+      const auto pid = fork();
+      if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        stop("Cannot fork");
+      }
+      if (pid == 0) {
+        // The child only writes to its own pipe
+        for (const auto& child : running) close(child.fd);
+        close(fds[0]);
+        int code = 0;
+        try {
+          const auto out = task(next);
+          for (std::size_t pos = 0; pos < out.size() && code == 0;) {
+            const auto len = write(fds[1], out.data() + pos, out.size() - pos);
+            if (len > 0) pos += len;
+            if (len < 0 && errno != EINTR) code = 1;
+          }
+        } catch (...) { code = 1; }
+        close(fds[1]);
+        _exit(code);
+      }
+      close(fds[1]);
+      running.push_back({pid, fds[0], next++});
+    }
+    if (!failed.empty()) stop("Stopped after a task failed");
+    return outputs;
+  }
+
+  /// Periods of the periodic angles among the parameters of the combiner (see CharmParameters::period).
+  std::map<std::string, double> parameter_periods(Combiner& combiner) {
+    std::map<std::string, double> periods;
+    for (const auto par : NuisanceProfiler::combinedParameters(combiner)) {
+      const auto period = CharmParameters::period(*static_cast<RooRealVar*>(par));
+      if (period > 0) periods[par->GetName()] = period;
+    }
+    return periods;
+  }
+
+  /// Difference a - b between two values of a parameter, the shortest one around the circle for the periodic angles.
+  double difference(const std::map<std::string, double>& periods, const std::string& name, const double a,
+                    const double b) {
+    const auto it = periods.find(name);
+    return it == periods.end() ? a - b : std::remainder(a - b, it->second);
+  }
+
+  /// Combiners selected by the GammaCombo option `-c`.
+  std::vector<scan_columns::SelectedCombiner> resolve_combiners(GammaComboEngine& gc, const std::vector<char*>& args,
+                                                               const std::string& caller) {
+    std::vector<scan_columns::SelectedCombiner> combiners;
+    for (const auto& option : io::option_values(args, "-c")) {
+      auto combiner = scan_columns::resolve_combiner(gc, option);
+      if (!combiner) {
+        throw std::runtime_error(std::format("{} ERROR Cannot refit the PDFs of combiner {}", caller, option));
+      }
+      combiners.push_back(std::move(*combiner));
+    }
+    if (combiners.empty()) throw std::runtime_error(std::format("{} ERROR Select the combiners with -c", caller));
+    return combiners;
+  }
+
+  /// Names of the parameters of the combiner that are neither constant nor fixed by --fix, in alphabetical order.
+  std::vector<std::string> floating_parameters(Combiner& combiner, const std::map<std::string, double>& fixed) {
+    std::vector<std::string> floating;
+    for (const auto par : NuisanceProfiler::combinedParameters(combiner)) {
+      if (!static_cast<RooRealVar*>(par)->isConstant() && !fixed.contains(par->GetName())) {
+        floating.push_back(par->GetName());
+      }
+    }
+    std::ranges::sort(floating);
+    return floating;
+  }
+
+  /// Scenario of a projection: scale factors of the statistical and systematic uncertainties, see Impact.h.
+  struct Scenario {
+    std::string name;
+    bool confirm;
+    std::vector<std::vector<double>> stat_scale;  ///< One vector per PDF, with one factor per observable.
+    std::vector<std::vector<double>> syst_scale;
+  };
+
+  /// Scenario with the current uncertainties.
+  Scenario nominal(const std::string& name, const std::vector<const PDF_Charm*>& pdfs) {
+    Scenario scenario{name, false, {}, {}};
+    for (const auto pdf : pdfs) {
+      scenario.stat_scale.emplace_back(pdf->measuredObservables().getSize(), 1.);
+      scenario.syst_scale.emplace_back(pdf->measuredObservables().getSize(), 1.);
+    }
+    return scenario;
+  }
+
+  std::vector<Scenario> read_scenarios(const fs::path& file, const std::vector<const PDF_Charm*>& pdfs) {
+    std::ifstream in(file);
+    if (!in) throw std::runtime_error(std::format("impact::project ERROR Cannot read {}", file.string()));
+
+    std::vector<Scenario> scenarios;
+    for (std::string line; std::getline(in, line);) {
+      std::istringstream tokens(line.substr(0, line.find('#')));
+      std::string name;
+      if (!(tokens >> name)) continue;
+      auto scenario = nominal(name, pdfs);
+
+      for (std::string token; tokens >> token;) {
+        if (token == "confirm") {
+          scenario.confirm = true;
+          continue;
+        }
+        // <pdf id>[:<observable>]=<scale>[/<systematic scale>]
+        const auto error = std::runtime_error(
+            std::format("impact::project ERROR Cannot parse \"{}\" of scenario {}", token, scenario.name));
+        const auto eq = token.find('=');
+        if (eq == std::string::npos) throw error;
+        const auto target = token.substr(0, eq);
+        const auto scales = token.substr(eq + 1);
+        const auto slash = scales.find('/');
+        const auto stat = parse_number<double>(scales.substr(0, slash), error);
+        const auto syst = slash == std::string::npos ? stat : parse_number<double>(scales.substr(slash + 1), error);
+        if (!(stat > 0 && syst > 0 && std::isfinite(stat) && std::isfinite(syst))) throw error;
+
+        const auto colon = target.find(':');
+        const auto id = parse_number<int>(target.substr(0, colon), error);
+        const auto pdf = std::ranges::find_if(pdfs, [id](const auto p) { return p->getGcId() == id; });
+        if (pdf == pdfs.end()) {
+          throw std::runtime_error(
+              std::format("impact::project ERROR PDF {} of scenario {} is not in the combiner", id, scenario.name));
+        }
+        const auto p = pdf - pdfs.begin();
+        bool found = false;
+        for (int i = 0; i < (*pdf)->measuredObservables().getSize(); ++i) {
+          if (colon != std::string::npos && target.substr(colon + 1) != (*pdf)->measuredObservables().at(i)->GetName())
+            continue;
+          scenario.stat_scale[p][i] = stat;
+          scenario.syst_scale[p][i] = syst;
+          found = true;
+        }
+        if (!found) throw error;
+      }
+      scenarios.push_back(std::move(scenario));
+    }
+    return scenarios;
+  }
+
+  /**
+   * Derivatives of the theory expressions of each PDF with respect to the floating parameters at the best fit, with
+   * central differences of 1% of the uncertainty of each parameter.
+   */
+  std::vector<TMatrixD> jacobians(const std::vector<const PDF_Charm*>& pdfs, const std::vector<std::string>& floating,
+                                  const Fit& best) {
+    // The RooRealVars of a parameter are shared between PDFs, or else have the same name
+    std::map<std::string, std::vector<RooRealVar*>> vars;
+    for (const auto pdf : pdfs) {
+      for (const auto par : pdf->theoryParameters()) vars[par->GetName()].push_back(static_cast<RooRealVar*>(par));
+    }
+    // Returns the actual shift of the parameter, which is one-sided at the limits of the range (unless it is an angle)
+    const auto set = [&vars](const std::string& name, const double value) {
+      const auto var = vars.at(name).front();
+      const auto period = CharmParameters::period(*var);
+      const auto wrapped = period > 0 ? value - period * std::floor((value - var->getMin()) / period) : value;
+      for (const auto v : vars.at(name)) v->setVal(wrapped);
+      return period > 0 ? value : var->getVal();
+    };
+    const auto theory = [&pdfs]() {
+      std::vector<std::vector<double>> values;
+      for (const auto pdf : pdfs) {
+        values.emplace_back();
+        for (const auto th : pdf->theoryExpressions()) values.back().push_back(static_cast<RooAbsReal*>(th)->getVal());
+      }
+      return values;
+    };
+    for (const auto& [name, par] : best.pars) {
+      if (vars.contains(name)) set(name, par.first);
+    }
+
+    std::vector<TMatrixD> jac;
+    for (const auto pdf : pdfs) jac.emplace_back(pdf->theoryExpressions().getSize(), floating.size());
+    for (std::size_t k = 0; k < floating.size(); ++k) {
+      const auto [value, error] = best.pars.at(floating[k]);
+      const auto step = error > 0 ? 1e-2 * error : 1e-4 * std::max(std::abs(value), 1.);
+      const auto up = set(floating[k], value + step);
+      const auto theory_up = theory();
+      const auto down = set(floating[k], value - step);
+      const auto theory_down = theory();
+      set(floating[k], value);
+      for (std::size_t p = 0; p < pdfs.size(); ++p) {
+        for (int i = 0; i < jac[p].GetNrows(); ++i) jac[p](i, k) = (theory_up[p][i] - theory_down[p][i]) / (up - down);
+      }
+    }
+    return jac;
+  }
+
+  /// Uncertainties of the floating parameters for the linearised theory, NaN if they are not constrained.
+  std::vector<double> linear_uncertainties(const std::vector<const PDF_Charm*>& pdfs, const std::vector<TMatrixD>& jac,
+                                           const std::size_t n_pars, const Scenario& scenario) {
+    TMatrixDSym fisher(n_pars);
+    for (std::size_t p = 0; p < pdfs.size(); ++p) {
+      auto inv_cov = pdfs[p]->covariance(scenario.stat_scale[p], scenario.syst_scale[p]);
+      inv_cov.Invert();
+      fisher += inv_cov.SimilarityT(jac[p]);
+    }
+    double det = 0.;
+    fisher.Invert(&det);
+    std::vector<double> errors;
+    for (std::size_t k = 0; k < n_pars; ++k) {
+      errors.push_back(det != 0. && fisher(k, k) > 0. ? std::sqrt(fisher(k, k)) : std::nan(""));
+    }
+    return errors;
+  }
+
+  /**
+   * Lower and upper profile-likelihood uncertainties of the floating parameters, for the Asimov data set of the best
+   * fit and the uncertainties of the scenario. The PDFs are rebuilt with the scaled uncertainties and with their
+   * observables at the theory of the best fit, and a clone of the combiner is combined from them. The points where
+   * its chi2 rises by one are found iteratively, starting from the linearised uncertainties. Changes the PDFs, so it
+   * runs in a child process.
+   */
+  Fit confirm(GammaComboEngine& gc, const scan_columns::SelectedCombiner& combiner,
+              const std::vector<std::string>& floating, const std::map<std::string, double>& fixed, const Fit& best,
+              const Scenario& scenario, const std::vector<double>& linear) {
+    for (std::size_t p = 0; p < combiner.pdfs.size(); ++p) {
+      const auto pdf = dynamic_cast<PDF_Charm*>(gc.getPdf(combiner.pdfs[p]->getGcId()));
+      for (const auto par : pdf->theoryParameters()) {
+        const auto it = best.pars.find(par->GetName());
+        if (it != best.pars.end()) static_cast<RooRealVar*>(par)->setVal(it->second.first);
+      }
+      pdf->scaleUncertainties(scenario.stat_scale[p], scenario.syst_scale[p]);
+      pdf->setObservablesTruth();
+    }
+    auto& asimov = *gc.getCombiner(scan_columns::clone_combiner(gc, combiner.id));
+
+    Fit f{{}, 0., 0};
+    for (std::size_t k = 0; k < floating.size(); ++k) {
+      NuisanceProfiler profiler(asimov, floating, {floating[k]});
+      for (const auto& [name, value] : fixed) profiler.setValue(name, value);
+
+      const auto [value, error] = best.pars.at(floating[k]);
+      double widths[2];
+      for (const int side : {0, 1}) {
+        auto width = std::isfinite(linear[k]) ? linear[k] : error;
+        for (int iter = 0; iter < 10; ++iter) {
+          for (const auto& [name, par] : best.pars) profiler.setValue(name, par.first, par.second);
+          const auto result = profiler.fit({side ? value + width : value - width});
+          if (result.status != 0) f.status = result.status;
+          if (!(result.chi2 > 0.) || std::abs(result.chi2 - 1.) < 1e-2) break;
+          width /= std::sqrt(result.chi2);
+        }
+        widths[side] = width;
+      }
+      f.pars[floating[k]] = {widths[0], widths[1]};
+    }
+    return f;
+  }
+
+  /**
+   * Bin centres of the grid along a scanned quantity, from the GammaCombo options or else +- 4 sigma around its value,
+   * clipped to its domain [min, max].
+   */
+  std::vector<double> preview_axis(const std::vector<char*>& args, const char* range_option, const char* points_option,
+                                   const int default_points, const double value, const double error,
+                                   const double min = -std::numeric_limits<double>::infinity(),
+                                   const double max = std::numeric_limits<double>::infinity()) {
+    auto lo = std::max(value - 4 * error, min);
+    auto hi = std::min(value + 4 * error, max);
+    if (const auto range = io::option_values(args, range_option); !range.empty()) {
+      const auto bad_option =
+          std::runtime_error(std::format("impact::preview ERROR Cannot parse {} {}", range_option, range.back()));
+      const auto colon = range.back().find(':');
+      if (colon == std::string::npos) throw bad_option;
+      lo = parse_number<double>(range.back().substr(0, colon), bad_option);
+      hi = parse_number<double>(range.back().substr(colon + 1), bad_option);
+    }
+    auto n = default_points;
+    if (const auto points = io::option_values(args, points_option); !points.empty()) {
+      const auto bad_option =
+          std::runtime_error(std::format("impact::preview ERROR Cannot parse {} {}", points_option, points.back()));
+      n = parse_number<int>(points.back(), bad_option);
+    }
+    std::vector<double> axis;
+    for (int i = 0; i < n; ++i) axis.push_back(lo + (i + 0.5) * (hi - lo) / n);
+    return axis;
+  }
+
+  /// Chi2 rise corresponding to `nsigma` Gaussian standard deviations, for two degrees of freedom.
+  double dchi2_2d(const double nsigma) { return -2 * std::log(std::erfc(nsigma / std::sqrt(2.))); }
+
+  /**
+   * Latin hypercube of `n` points in the unit cube of dimension `dim`: along each axis, the points fall in the `n`
+   * intervals of width 1 / n in a random order.
+   */
+  std::vector<std::vector<double>> latin_hypercube(const std::size_t n, const std::size_t dim, std::mt19937& rng) {
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    std::vector<std::vector<double>> points(n, std::vector<double>(dim));
+    std::vector<std::size_t> order(n);
+    for (std::size_t d = 0; d < dim; ++d) {
+      std::iota(order.begin(), order.end(), 0);
+      std::ranges::shuffle(order, rng);
+      for (std::size_t i = 0; i < n; ++i) points[i][d] = (order[i] + uniform(rng)) / n;
+    }
+    return points;
+  }
+
+  /**
+   * Range of the start values of a parameter: its scan range (see CharmParameters.cpp) within its limits, or the full
+   * turn for the periodic angles.
+   */
+  std::pair<double, double> start_range(Combiner& combiner, const std::string& name) {
+    const auto var = static_cast<RooRealVar*>(NuisanceProfiler::combinedParameters(combiner).find(name.c_str()));
+    if (!var) return {0., 0.};
+    const bool scan = var->hasRange("scan") && CharmParameters::period(*var) == 0;
+    return {std::max(scan ? var->getMin("scan") : var->getMin(), var->getMin()),
+            std::min(scan ? var->getMax("scan") : var->getMax(), var->getMax())};
+  }
+
+  /**
+   * Distinct minima among the converged fits (among all of them, if none converged), in order of increasing chi2, with
+   * the number of fits that found each. Two fits find the same minimum if all parameters agree within 0.1 sigma.
+   */
+  std::vector<std::pair<Fit, int>> distinct_minima(std::vector<Fit> fits,
+                                                   const std::map<std::string, double>& periods) {
+    std::ranges::sort(fits, {}, &Fit::chi2);
+    const bool any_converged = std::ranges::any_of(fits, [](const Fit& f) { return f.status == 0; });
+    std::vector<std::pair<Fit, int>> minima;
+    for (auto& f : fits) {
+      if (any_converged && f.status != 0) continue;
+      const auto same = [&f, &periods](const std::pair<Fit, int>& minimum) {
+        return std::ranges::all_of(minimum.first.pars, [&f, &periods](const auto& par) {
+          const auto [value, error] = f.pars.at(par.first);
+          return std::abs(difference(periods, par.first, value, par.second.first)) <=
+                 0.1 * std::max(error, par.second.second);
+        });
+      };
+      if (const auto it = std::ranges::find_if(minima, same); it != minima.end())
+        ++it->second;
+      else
+        minima.emplace_back(std::move(f), 1);
+    }
+    return minima;
+  }
+
+  /**
+   * Write solutions in the format of the start parameter files of GammaCombo (option --parfile), which is also that of
+   * its fit results in plots/par/, read by the Python driver. Each solution is preceded by a comment line.
+   */
+  void write_parfile(const fs::path& file, const std::vector<std::pair<const Fit*, std::string>>& solutions,
+                     const std::string& caller) {
+    fs::create_directories(file.parent_path());
+    std::ofstream out(file);
+    out << "# ParameterName                  value       errLow      errHigh\n";
+    for (std::size_t m = 0; m < solutions.size(); ++m) {
+      const auto& [solution, comment] = solutions[m];
+      out << std::format("\n----- SOLUTION {} -----\n### {}\n", m, comment);
+      for (const auto& [par, value] : solution->pars) {
+        out << std::format("{:<24} {:>13.6g} {:>12.6g} {:>12.6g}\n", par, value.first, -value.second, value.second);
+      }
+    }
+    if (!out) throw std::runtime_error(std::format("{} ERROR Cannot write {}", caller, file.string()));
+    std::cout << "INFO " << caller << ": written " << file << std::endl;
+  }
+
+  /**
+   * Write a scan in the format of the scanner files of GammaCombo, i.e. the histograms hCL and hChi2min of 1 - CL and
+   * of the minimum chi2 over the grid `axes` of bin centres, with `cl` and `chi2` in C order.
+   */
+  void write_scanner_file(const fs::path& file, const std::vector<std::string>& axis_titles,
+                          const std::vector<std::vector<double>>& axes, const std::vector<double>& cl,
+                          const std::vector<double>& chi2) {
+    // The bin edges lie halfway between the equally spaced centres
+    const auto edges = [](const std::vector<double>& axis) {
+      const auto half = axis.size() > 1 ? (axis.back() - axis.front()) / (axis.size() - 1) / 2 : 0.5;
+      return std::pair{axis.front() - half, axis.back() + half};
+    };
+    const auto nx = static_cast<int>(axes[0].size());
+    const auto ny = axes.size() > 1 ? static_cast<int>(axes[1].size()) : 1;
+    const auto [xlo, xhi] = edges(axes[0]);
+    std::vector<std::unique_ptr<TH1>> hists;
+    for (const auto& [name, values] : {std::pair{"hCL", &cl}, std::pair{"hChi2min", &chi2}}) {
+      if (axes.size() > 1) {
+        const auto [ylo, yhi] = edges(axes[1]);
+        hists.push_back(std::make_unique<TH2D>(name, name, nx, xlo, xhi, ny, ylo, yhi));
+        hists.back()->GetYaxis()->SetTitle(axis_titles[1].c_str());
+      } else {
+        hists.push_back(std::make_unique<TH1D>(name, name, nx, xlo, xhi));
+      }
+      hists.back()->SetDirectory(nullptr);
+      hists.back()->GetXaxis()->SetTitle(axis_titles[0].c_str());
+      for (int i = 0; i < nx; ++i) {
+        for (int j = 0; j < ny; ++j) {
+          if (axes.size() > 1)
+            hists.back()->SetBinContent(i + 1, j + 1, (*values)[i * ny + j]);
+          else
+            hists.back()->SetBinContent(i + 1, (*values)[i]);
+        }
+      }
+    }
+
+    fs::create_directories(file.parent_path());
+    const auto out = std::unique_ptr<TFile>(TFile::Open(file.c_str(), "RECREATE"));
+    if (!out || out->IsZombie()) {
+      throw std::runtime_error(std::format("impact::scan_derived ERROR Cannot write {}", file.string()));
+    }
+    for (const auto& h : hists) out->WriteTObject(h.get());
+    out->Close();
+    std::cout << "INFO impact::scan_derived: written " << file << std::endl;
+  }
+}  // namespace
+
+void impact::run(GammaComboEngine& gc, const std::string& engine_name, const std::vector<char*>& args,
+                 const std::vector<std::string>& candidates) {
+  const auto fixed = io::fixed_values(args);
+  const auto num_procs = std::max(std::thread::hardware_concurrency(), 1u);
+  std::vector<int> candidate_ids;
+  for (const auto& list : candidates) {
+    std::stringstream ids(list);
+    for (std::string token; std::getline(ids, token, ',');) {
+      const auto error =
+          std::runtime_error(std::format("impact::run ERROR Cannot parse the PDF id \"{}\" of --impact-add", token));
+      candidate_ids.push_back(parse_number<int>(token, error));
+      if (!gc.pdfExists(candidate_ids.back())) {
+        throw std::runtime_error(std::format("impact::run ERROR PDF {} of --impact-add does not exist", token));
+      }
+    }
+  }
+
+  for (const auto& [name, id, pdfs] : resolve_combiners(gc, args, "impact::run")) {
+    auto& combiner = *gc.getCombiner(id);
+    const auto floating = floating_parameters(combiner, fixed);
+    const auto periods = parameter_periods(combiner);
+    const auto global = fit(combiner, floating, fixed, nullptr);
+    std::cout << std::format("INFO impact::run: combiner {}, global fit: chi2 = {:.3f} (status {})\n", name,
+                             global.chi2, global.status);
+
+    // The PDF is removed from a clone of the combiner, which is combined anew
+    std::vector<int> removed_ids;
+    for (const auto pdf : pdfs) removed_ids.push_back(pdf->getGcId());
+    const auto removed_outputs = run_forked(removed_ids.size(), num_procs, [&](const std::size_t i) {
+      auto& others = *gc.getCombiner(scan_columns::clone_combiner(gc, id));
+      others.delPdf(gc.getPdf(removed_ids[i]));
+      return serialise(fit(others, floating, fixed, &global));
+    });
+
+    // The candidates that are not in the combiner are added to a clone, where the parameters they add float, too
+    std::vector<int> added_ids;
+    for (const auto candidate : candidate_ids) {
+      if (std::ranges::find(removed_ids, candidate) != removed_ids.end() ||
+          std::ranges::find(added_ids, candidate) != added_ids.end()) {
+        std::cout << std::format("INFO impact::run: PDF {} is already in combiner {}\n", candidate, name);
+      } else {
+        added_ids.push_back(candidate);
+      }
+    }
+    const auto added_outputs = run_forked(added_ids.size(), num_procs, [&](const std::size_t i) {
+      auto& more = *gc.getCombiner(scan_columns::clone_combiner(gc, id));
+      more.addPdf(gc[added_ids[i]]);
+      return serialise(fit(more, floating_parameters(more, fixed), fixed, &global));
+    });
+
+    // Shift and change of the uncertainty of each parameter with respect to the global fit, NaN if it is not
+    // constrained in the refit
+    struct Refit {
+      int id;
+      std::string title;
+      Fit fit;
+      std::vector<double> shifts;
+      std::vector<double> error_changes;
+    };
+    const auto refits = [&](const std::vector<int>& ids, const std::vector<std::string>& outputs) {
+      std::vector<Refit> rows;
+      for (std::size_t i = 0; i < ids.size(); ++i) {
+        rows.push_back({ids[i], gc.getPdf(ids[i])->getTitle().Data(), deserialise(outputs[i]), {}, {}});
+        for (const auto& par : floating) {
+          const auto [value, error] = global.pars.at(par);
+          const auto it = rows.back().fit.pars.find(par);
+          const bool constrained = it != rows.back().fit.pars.end() && it->second.second > 0;
+          rows.back().shifts.push_back(constrained ? difference(periods, par, it->second.first, value) : std::nan(""));
+          rows.back().error_changes.push_back(constrained ? it->second.second - error : std::nan(""));
+        }
+      }
+      return rows;
+    };
+    const auto removed = refits(removed_ids, removed_outputs);
+    const auto added = refits(added_ids, added_outputs);
+
+    for (const auto& [rows, with] : {std::pair{&removed, "without"}, std::pair{&added, "with"}}) {
+      for (const auto& row : *rows) {
+        std::cout << std::format("INFO impact::run: {} PDF {} ({}): chi2 = {:.3f} (status {})\n", with, row.id,
+                                 row.title, row.fit.chi2, row.fit.status);
+        for (std::size_t p = 0; p < floating.size(); ++p) {
+          const auto error = global.pars.at(floating[p]).second;
+          if (std::isnan(row.shifts[p])) {
+            std::cout << std::format("    {:<20} not constrained\n", floating[p]);
+          } else {
+            std::cout << std::format(
+                "    {:<20} shift {:+11.4e} ({:+6.2f} sigma), uncertainty {:+11.4e} ({:+6.1f}%)\n", floating[p],
+                row.shifts[p], row.shifts[p] / error, row.error_changes[p], 100. * row.error_changes[p] / error);
+          }
+        }
+      }
+    }
+
+    fs::create_directories(impact_dir);
+    const auto out_file = impact_dir / std::format("{}_{}.json", engine_name, name);
+    std::ofstream out(out_file);
+    std::vector<double> values, errors;
+    for (const auto& par : floating) {
+      values.push_back(global.pars.at(par).first);
+      errors.push_back(global.pars.at(par).second);
+    }
+    const auto write_refits = [&out](const std::vector<Refit>& rows) {
+      out << "[";
+      for (std::size_t i = 0; i < rows.size(); ++i) {
+        out << (i > 0 ? "," : "") << "\n    {\n"
+            << "      \"pdf\": " << rows[i].id << ",\n"
+            << "      \"title\": " << io::json_string(rows[i].title) << ",\n"
+            << "      \"chi2\": " << io::json_number(rows[i].fit.chi2) << ",\n"
+            << "      \"status\": " << rows[i].fit.status << ",\n"
+            << "      \"shifts\": " << io::json_list(rows[i].shifts, io::json_number) << ",\n"
+            << "      \"uncertainty_changes\": " << io::json_list(rows[i].error_changes, io::json_number) << "\n"
+            << "    }";
+      }
+      out << (rows.empty() ? "]" : "\n  ]");
+    };
+    out << "{\n"
+        << "  \"combiner\": " << io::json_string(name) << ",\n"
+        << "  \"parameters\": " << io::json_list(floating, io::json_string) << ",\n"
+        << "  \"values\": " << io::json_list(values, io::json_number) << ",\n"
+        << "  \"uncertainties\": " << io::json_list(errors, io::json_number) << ",\n"
+        << "  \"chi2\": " << io::json_number(global.chi2) << ",\n"
+        << "  \"status\": " << global.status << ",\n"
+        << "  \"removed\": ";
+    write_refits(removed);
+    out << ",\n  \"added\": ";
+    write_refits(added);
+    out << "\n}\n";
+    if (!out) throw std::runtime_error(std::format("impact::run ERROR Cannot write {}", out_file.string()));
+    std::cout << "INFO impact::run: written " << out_file << std::endl;
+  }
+}
+
+void impact::project(GammaComboEngine& gc, const std::string& engine_name, const std::vector<char*>& args,
+                     const fs::path& scenario_file) {
+  const auto fixed = io::fixed_values(args);
+  const auto num_procs = std::max(std::thread::hardware_concurrency(), 1u);
+
+  for (const auto& selected : resolve_combiners(gc, args, "impact::project")) {
+    const auto& [name, id, pdfs] = selected;
+    auto& combiner = *gc.getCombiner(id);
+    const auto floating = floating_parameters(combiner, fixed);
+    const auto scenarios = read_scenarios(scenario_file, pdfs);
+    const auto best = fit(combiner, floating, fixed, nullptr);
+    std::cout << std::format("INFO impact::project: combiner {}, global fit: chi2 = {:.3f} (status {})\n", name,
+                             best.chi2, best.status);
+
+    const auto jac = jacobians(pdfs, floating, best);
+    const auto linear = linear_uncertainties(pdfs, jac, floating.size(), nominal("current", pdfs));
+    std::vector<std::vector<double>> projected;
+    for (const auto& scenario : scenarios) {
+      projected.push_back(linear_uncertainties(pdfs, jac, floating.size(), scenario));
+    }
+
+    // Profile-likelihood intervals of the flagged scenarios, each in its own process since the PDFs change
+    std::vector<std::size_t> confirmed;
+    for (std::size_t s = 0; s < scenarios.size(); ++s) {
+      if (scenarios[s].confirm) confirmed.push_back(s);
+    }
+    const auto outputs = run_forked(confirmed.size(), num_procs, [&](const std::size_t i) {
+      const auto s = confirmed[i];
+      return serialise(confirm(gc, selected, floating, fixed, best, scenarios[s], projected[s]));
+    });
+    std::map<std::size_t, Fit> intervals;
+    for (std::size_t i = 0; i < confirmed.size(); ++i) intervals[confirmed[i]] = deserialise(outputs[i]);
+
+    std::cout << std::format("    {:<20} {:>12} {:>12} {:>12}", "parameter", "value", "hesse", "linear");
+    for (const auto& scenario : scenarios) std::cout << std::format(" {:>12}", scenario.name);
+    std::cout << "\n";
+    for (std::size_t k = 0; k < floating.size(); ++k) {
+      const auto [value, error] = best.pars.at(floating[k]);
+      std::cout << std::format("    {:<20} {:>12.4e} {:>12.4e} {:>12.4e}", floating[k], value, error, linear[k]);
+      for (const auto& errors : projected) std::cout << std::format(" {:>12.4e}", errors[k]);
+      std::cout << "\n";
+    }
+    for (const auto& [s, interval] : intervals) {
+      std::cout << std::format("INFO impact::project: scenario {}, profile-likelihood intervals (status {}):\n",
+                               scenarios[s].name, interval.status);
+      for (std::size_t k = 0; k < floating.size(); ++k) {
+        const auto [lower, upper] = interval.pars.at(floating[k]);
+        std::cout << std::format("    {:<20} -{:.4e} +{:.4e} (linear {:.4e})\n", floating[k], lower, upper,
+                                 projected[s][k]);
+      }
+    }
+
+    fs::create_directories(projection_dir);
+    const auto out_file = projection_dir / std::format("{}_{}.json", engine_name, name);
+    std::ofstream out(out_file);
+    std::vector<double> values, errors;
+    for (const auto& par : floating) {
+      values.push_back(best.pars.at(par).first);
+      errors.push_back(best.pars.at(par).second);
+    }
+    out << "{\n"
+        << "  \"combiner\": " << io::json_string(name) << ",\n"
+        << "  \"parameters\": " << io::json_list(floating, io::json_string) << ",\n"
+        << "  \"values\": " << io::json_list(values, io::json_number) << ",\n"
+        << "  \"uncertainties\": " << io::json_list(errors, io::json_number) << ",\n"
+        << "  \"uncertainties_linear\": " << io::json_list(linear, io::json_number) << ",\n"
+        << "  \"scenarios\": [";
+    for (std::size_t s = 0; s < scenarios.size(); ++s) {
+      out << (s > 0 ? "," : "") << "\n    {\n"
+          << "      \"name\": " << io::json_string(scenarios[s].name) << ",\n"
+          << "      \"uncertainties\": " << io::json_list(projected[s], io::json_number) << ",\n";
+      if (intervals.contains(s)) {
+        std::vector<double> lower, upper;
+        for (const auto& par : floating) {
+          lower.push_back(intervals[s].pars.at(par).first);
+          upper.push_back(intervals[s].pars.at(par).second);
+        }
+        out << "      \"confirmed_lower\": " << io::json_list(lower, io::json_number) << ",\n"
+            << "      \"confirmed_upper\": " << io::json_list(upper, io::json_number) << "\n";
+      } else {
+        out << "      \"confirmed_lower\": null,\n"
+            << "      \"confirmed_upper\": null\n";
+      }
+      out << "    }";
+    }
+    out << "\n  ]\n}\n";
+    if (!out) throw std::runtime_error(std::format("impact::project ERROR Cannot write {}", out_file.string()));
+    std::cout << "INFO impact::project: written " << out_file << std::endl;
+  }
+}
+
+void impact::preview(GammaComboEngine& gc, const std::string& engine_name, const std::vector<char*>& args) {
+  const auto fixed = io::fixed_values(args);
+  const auto vars = io::option_values(args, "--var");
+  if (vars.empty() || vars.size() > 2) {
+    throw std::runtime_error("impact::preview ERROR Select one or two parameters with --var");
+  }
+
+  for (const auto& [name, id, pdfs] : resolve_combiners(gc, args, "impact::preview")) {
+    auto& combiner = *gc.getCombiner(id);
+    const auto floating = floating_parameters(combiner, fixed);
+    const auto periods = parameter_periods(combiner);
+    NuisanceProfiler profiler(combiner, floating, {});
+    for (const auto& [par, value] : fixed) profiler.setValue(par, value);
+    const auto result = profiler.fit({}, {}, true);
+    const auto& names = profiler.parameters();
+    std::cout << std::format("INFO impact::preview: combiner {}, global fit: chi2 = {:.3f} (status {})\n", name,
+                             result.chi2, result.status)
+              << "INFO impact::preview: GAUSSIAN APPROXIMATION from the HESSE matrix at the global minimum, not a "
+                 "profile-likelihood scan\n";
+
+    // Gaussian intervals of each scanned parameter
+    std::vector<std::size_t> index;
+    for (const auto& var : vars) {
+      const auto i = std::ranges::find(names, var) - names.begin();
+      if (std::ranges::find(floating, var) == floating.end() || !(result.covariance(i, i) > 0)) {
+        throw std::runtime_error(
+            std::format("impact::preview ERROR Parameter {} is not constrained by combiner {}", var, name));
+      }
+      index.push_back(i);
+      const auto value = result.values[i];
+      const auto error = std::sqrt(result.covariance(i, i));
+      std::cout << std::format("    {:<20} {:+.4e}", var, value);
+      for (const int n : {1, 2, 3}) {
+        std::cout << std::format("  [{:+.4e}, {:+.4e}]", value - n * error, value + n * error);
+      }
+      std::cout << "\n";
+    }
+
+    // Ellipses of the 1, 2 and 3 sigma regions, from the eigenvalues of the covariance of the two parameters
+    TMatrixDSym cov(vars.size());
+    for (std::size_t k = 0; k < vars.size(); ++k) {
+      for (std::size_t l = 0; l < vars.size(); ++l) cov(k, l) = result.covariance(index[k], index[l]);
+    }
+    if (vars.size() == 2) {
+      const auto mean = (cov(0, 0) + cov(1, 1)) / 2;
+      const auto diff = std::hypot((cov(0, 0) - cov(1, 1)) / 2, cov(0, 1));
+      const auto angle = std::atan2(2 * cov(0, 1), cov(0, 0) - cov(1, 1)) / 2;
+      std::cout << std::format("    correlation {:+.3f}, ellipse axes rotated by {:+.4f} rad:\n",
+                               cov(0, 1) / std::sqrt(cov(0, 0) * cov(1, 1)), angle);
+      for (const int n : {1, 2, 3}) {
+        std::cout << std::format("    {} sigma: semi-axes {:.4e}, {:.4e}\n", n, std::sqrt((mean + diff) * dchi2_2d(n)),
+                                 std::sqrt(std::max(mean - diff, 0.) * dchi2_2d(n)));
+      }
+    }
+
+    // Grid in the same format as the scans
+    std::vector<std::vector<double>> axes;
+    for (std::size_t k = 0; k < vars.size(); ++k) {
+      const auto value = result.values[index[k]];
+      const auto error = std::sqrt(cov(k, k));
+      axes.push_back(vars.size() == 1 ? preview_axis(args, "--scanrange", "--npoints", 200, value, error)
+                     : k == 0         ? preview_axis(args, "--scanrange", "--npoints2dx", 100, value, error)
+                                      : preview_axis(args, "--scanrangey", "--npoints2dy", 100, value, error));
+    }
+    cov.Invert();
+    std::vector<double> cl, chi2min;
+    const auto ny = vars.size() > 1 ? axes[1].size() : 1;
+    for (std::size_t i = 0; i < axes[0].size(); ++i) {
+      for (std::size_t j = 0; j < ny; ++j) {
+        const auto dx = difference(periods, vars[0], axes[0][i], result.values[index[0]]);
+        const auto dy = vars.size() > 1 ? difference(periods, vars[1], axes[1][j], result.values[index[1]]) : 0.;
+        const auto dchi2 = vars.size() > 1 ? cov(0, 0) * dx * dx + 2 * cov(0, 1) * dx * dy + cov(1, 1) * dy * dy
+                                           : cov(0, 0) * dx * dx;
+        cl.push_back(vars.size() > 1 ? std::exp(-dchi2 / 2) : std::erfc(std::sqrt(dchi2 / 2)));
+        chi2min.push_back(result.chi2 + dchi2);
+      }
+    }
+    std::vector<double> solution;
+    for (const auto& par : floating) solution.push_back(result.values[std::ranges::find(names, par) - names.begin()]);
+    std::string suffix;
+    for (const auto& var : vars) suffix += "_" + var;
+    scan_columns::write(std::format("{}_preview_{}{}", engine_name, name, suffix), approximation, vars, axes, cl,
+                        chi2min, {}, floating, solution, result.chi2 / 2);
+
+    // Values, uncertainties and correlations of all parameters, e.g. to choose the ranges of the scans
+    fs::create_directories(preview_dir);
+    const auto out_file = preview_dir / std::format("{}_{}.json", engine_name, name);
+    std::ofstream out(out_file);
+    std::vector<double> values, errors;
+    for (const auto& par : floating) {
+      const auto i = std::ranges::find(names, par) - names.begin();
+      values.push_back(result.values[i]);
+      errors.push_back(std::sqrt(result.covariance(i, i)));
+    }
+    out << "{\n"
+        << "  \"combiner\": " << io::json_string(name) << ",\n"
+        << "  \"approximation\": " << io::json_string(approximation) << ",\n"
+        << "  \"parameters\": " << io::json_list(floating, io::json_string) << ",\n"
+        << "  \"values\": " << io::json_list(values, io::json_number) << ",\n"
+        << "  \"uncertainties\": " << io::json_list(errors, io::json_number) << ",\n"
+        << "  \"correlations\": [";
+    for (std::size_t k = 0; k < floating.size(); ++k) {
+      const auto i = std::ranges::find(names, floating[k]) - names.begin();
+      std::vector<double> row;
+      for (const auto& par : floating) {
+        const auto j = std::ranges::find(names, par) - names.begin();
+        row.push_back(result.covariance(i, j) / std::sqrt(result.covariance(i, i) * result.covariance(j, j)));
+      }
+      out << (k > 0 ? "," : "") << "\n    " << io::json_list(row, io::json_number);
+    }
+    out << "\n  ],\n"
+        << "  \"chi2\": " << io::json_number(result.chi2) << ",\n"
+        << "  \"status\": " << result.status << "\n"
+        << "}\n";
+    if (!out) throw std::runtime_error(std::format("impact::preview ERROR Cannot write {}", out_file.string()));
+    std::cout << "INFO impact::preview: written " << out_file << std::endl;
+  }
+}
+
+void impact::multistart(GammaComboEngine& gc, const std::string& engine_name, const std::vector<char*>& args,
+                        const int num_starts, const unsigned seed) {
+  if (num_starts < 1) throw std::runtime_error("impact::multistart ERROR --multistart requires a positive number");
+  const auto fixed = io::fixed_values(args);
+  const auto num_procs = std::max(std::thread::hardware_concurrency(), 1u);
+
+  for (const auto& [name, id, pdfs] : resolve_combiners(gc, args, "impact::multistart")) {
+    auto& combiner = *gc.getCombiner(id);
+    const auto floating = floating_parameters(combiner, fixed);
+    std::vector<std::pair<double, double>> ranges;
+    for (const auto& par : floating) ranges.push_back(start_range(combiner, par));
+    std::mt19937 rng(seed);
+    const auto points = latin_hypercube(num_starts, floating.size(), rng);
+
+    // Parameters without a finite range start from their current value
+    const auto outputs = run_forked(num_starts, num_procs, [&](const std::size_t i) {
+      Fit start{{}, 0., 0};
+      for (std::size_t k = 0; k < floating.size(); ++k) {
+        const auto [lo, hi] = ranges[k];
+        if (std::isfinite(lo) && std::isfinite(hi) && hi > lo) {
+          start.pars[floating[k]] = {lo + points[i][k] * (hi - lo), (hi - lo) / 20};
+        }
+      }
+      return serialise(fit(combiner, floating, fixed, &start));
+    });
+    std::vector<Fit> fits;
+    for (const auto& output : outputs) fits.push_back(deserialise(output));
+    auto minima = distinct_minima(fits, parameter_periods(combiner));
+    if (minima.empty()) throw std::runtime_error(std::format("impact::multistart ERROR No fit of combiner {}", name));
+
+    // The forked fits leave the combiner untouched: refit it from the best minimum, which leaves its workspace there
+    auto& best = minima.front().first;
+    best = fit(combiner, floating, fixed, &best);
+
+    std::cout << std::format("INFO impact::multistart: combiner {}, {} distinct minima found by {} starts:\n", name,
+                             minima.size(), num_starts);
+    for (std::size_t m = 0; m < minima.size(); ++m) {
+      const auto& [minimum, count] = minima[m];
+      std::cout << std::format("    minimum {}: chi2 = {:.4f} (+{:.4f}), status {}, found by {} starts\n", m,
+                               minimum.chi2, minimum.chi2 - minima.front().first.chi2, minimum.status, count);
+      for (const auto& [par, value] : minimum.pars) {
+        std::cout << std::format("        {:<20} {:+.6e} +- {:.6e}\n", par, value.first, value.second);
+      }
+    }
+
+    // Start parameter file of GammaCombo (option --parfile), which starts from the first solution
+    std::vector<std::pair<const Fit*, std::string>> solutions;
+    for (const auto& [minimum, count] : minima) {
+      solutions.emplace_back(&minimum, std::format("chi2: {:.6g}, status: {}, found by {} of {} starts", minimum.chi2,
+                                                   minimum.status, count, num_starts));
+    }
+    write_parfile(multistart_dir / std::format("{}_{}_{}starts_seed{}.dat", engine_name, name, num_starts, seed),
+                  solutions, "impact::multistart");
+  }
+}
+
+void impact::scan_derived(GammaComboEngine& gc, const std::string& engine_name, const std::vector<char*>& args,
+                          const std::vector<std::string>& derived,
+                          const std::map<std::string, PredefinedQuantity>& predefined) {
+  const auto fixed = io::fixed_values(args);
+  const auto vars = io::option_values(args, "--var");
+  const auto num_procs = std::max(std::thread::hardware_concurrency(), 1u);
+  std::vector<NuisanceProfiler::Derived> quantities;
+  // Domain of each quantity, unknown for those given by an expression
+  std::vector<std::optional<std::pair<double, double>>> domains;
+  for (const auto& arg : derived) {
+    if (const auto eq = arg.find('='); eq != std::string::npos) {
+      quantities.push_back({arg.substr(0, eq), arg.substr(eq + 1)});
+      domains.push_back(std::nullopt);
+    } else if (const auto it = predefined.find(arg); it != predefined.end()) {
+      quantities.push_back({arg, it->second.expression});
+      domains.emplace_back(std::pair{it->second.min, it->second.max});
+    } else {
+      throw std::runtime_error(std::format(
+          "impact::scan_derived ERROR Quantity {} is not predefined, give it as --derived {}=<expression>", arg, arg));
+    }
+  }
+  if (vars.size() + quantities.size() > 2) {
+    throw std::runtime_error("impact::scan_derived ERROR Scan at most two quantities with --derived and --var");
+  }
+  auto axis_names = vars;
+  for (const auto& quantity : quantities) axis_names.push_back(quantity.name);
+  const auto range_option = [](const std::size_t k) { return k == 0 ? "--scanrange" : "--scanrangey"; };
+  for (std::size_t k = vars.size(); k < axis_names.size(); ++k) {
+    if (!domains[k - vars.size()] && io::option_values(args, range_option(k)).empty()) {
+      throw std::runtime_error(std::format("impact::scan_derived ERROR Set the range of {} with {} (unknown domain)",
+                                           axis_names[k], range_option(k)));
+    }
+  }
+
+  for (const auto& [name, id, pdfs] : resolve_combiners(gc, args, "impact::scan_derived")) {
+    auto& combiner = *gc.getCombiner(id);
+    const auto floating = floating_parameters(combiner, fixed);
+    for (const auto& var : vars) {
+      if (std::ranges::find(floating, var) == floating.end()) {
+        throw std::runtime_error(
+            std::format("impact::scan_derived ERROR Parameter {} does not float in combiner {}", var, name));
+      }
+    }
+
+    // Global minimum, and linear uncertainties of the scanned quantities to set the default grid
+    NuisanceProfiler global(combiner, floating, {}, quantities);
+    for (const auto& [par, value] : fixed) global.setValue(par, value);
+    const auto minimum = global.fit({}, {}, true);
+    const auto& names = global.parameters();
+    std::vector<std::pair<double, double>> centres;
+    std::vector<std::optional<std::pair<double, double>>> limits;  // Limits of the parameters, then the domains
+    for (const auto& var : vars) {
+      const auto i = std::ranges::find(names, var) - names.begin();
+      centres.emplace_back(minimum.values[i], std::sqrt(minimum.covariance(i, i)));
+      const auto par = static_cast<RooRealVar*>(NuisanceProfiler::combinedParameters(combiner).find(var.c_str()));
+      limits.emplace_back(std::pair{par->getMin(), par->getMax()});
+    }
+    std::ranges::copy(global.derivedValues(minimum), std::back_inserter(centres));
+    std::ranges::copy(domains, std::back_inserter(limits));
+    std::cout << std::format("INFO impact::scan_derived: combiner {}, global fit: chi2 = {:.3f} (status {})\n", name,
+                             minimum.chi2, minimum.status);
+    for (std::size_t k = 0; k < axis_names.size(); ++k) {
+      std::cout << std::format("    {:<20} {:+.4e} +- {:.4e}\n", axis_names[k], centres[k].first, centres[k].second);
+    }
+
+    std::vector<std::vector<double>> axes;
+    for (std::size_t k = 0; k < axis_names.size(); ++k) {
+      const auto [value, error] = centres[k];
+      const auto [min, max] = limits[k].value_or(
+          std::pair{-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()});
+      const auto points_option = axis_names.size() == 1 ? "--npoints" : k == 0 ? "--npoints2dx" : "--npoints2dy";
+      axes.push_back(preview_axis(args, range_option(k), points_option, axis_names.size() == 1 ? 200 : 100, value,
+                                  error, min, max));
+    }
+
+    // One row of the grid per process, each point starting from the previous one in the row
+    const auto ny = axes.size() > 1 ? axes[1].size() : 1;
+    const auto outputs = run_forked(axes[0].size(), num_procs, [&](const std::size_t i) {
+      NuisanceProfiler profiler(combiner, floating, vars, quantities);
+      std::string out;
+      for (std::size_t j = 0; j < ny; ++j) {
+        std::vector<double> point{axes[0][i]};
+        if (axes.size() > 1) point.push_back(axes[1][j]);
+        const auto result = profiler.fit(point, j == 0 ? minimum.values : std::vector<double>{});
+        out += std::format("{:.17g} {}\n", result.chi2, result.status);
+      }
+      return out;
+    });
+    std::vector<double> chi2;
+    std::vector<int> status;
+    for (const auto& output : outputs) {
+      std::istringstream in(output);
+      double value;
+      int point_status;
+      while (in >> value >> point_status) {
+        chi2.push_back(value);
+        status.push_back(point_status);
+      }
+    }
+    if (chi2.size() != axes[0].size() * ny) {
+      throw std::runtime_error(std::format("impact::scan_derived ERROR Incomplete scan of combiner {}", name));
+    }
+
+    // The points whose fit failed are masked, and do not set the minimum
+    const auto failed = std::ranges::count_if(status, [](const int s) { return s != 0; });
+    if (failed == static_cast<std::ptrdiff_t>(chi2.size())) {
+      throw std::runtime_error(std::format("impact::scan_derived ERROR No fit of combiner {} converged", name));
+    }
+    if (failed > 0) {
+      std::cout << std::format("INFO impact::scan_derived: {} of {} points did not converge, masked with NaN\n", failed,
+                               chi2.size());
+    }
+    auto chi2_best = minimum.chi2;
+    for (std::size_t p = 0; p < chi2.size(); ++p) {
+      if (status[p] == 0) chi2_best = std::min(chi2_best, chi2[p]);
+    }
+    std::vector<double> cl;
+    for (std::size_t p = 0; p < chi2.size(); ++p) {
+      if (status[p] != 0) {
+        chi2[p] = std::nan("");
+        cl.push_back(std::nan(""));
+        continue;
+      }
+      const auto dchi2 = std::max(chi2[p] - chi2_best, 0.);
+      cl.push_back(axes.size() > 1 ? std::exp(-dchi2 / 2) : std::erfc(std::sqrt(dchi2 / 2)));
+    }
+
+    std::vector<double> solution;
+    Fit best{{}, minimum.chi2, minimum.status};
+    for (const auto& par : floating) {
+      const auto i = std::ranges::find(names, par) - names.begin();
+      solution.push_back(minimum.values[i]);
+      best.pars[par] = {minimum.values[i], std::sqrt(minimum.covariance(i, i))};
+    }
+    for (std::size_t k = vars.size(); k < axis_names.size(); ++k) best.pars[axis_names[k]] = centres[k];
+    std::string suffix;
+    for (const auto& axis : axis_names) suffix += "_" + axis;
+    write_scanner_file(scanner_dir / std::format("{}_derived_scanner_{}{}.root", engine_name, name, suffix),
+                       axis_names, axes, cl, chi2);
+    write_parfile(par_dir / std::format("{}_derived_{}{}.dat", engine_name, name, suffix),
+                  {{&best, std::format("chi2: {:.6g}, status: {}, global minimum", best.chi2, best.status)}},
+                  "impact::scan_derived");
+    scan_columns::write(std::format("{}_derived_{}{}", engine_name, name, suffix), "profile", axis_names, axes, cl,
+                        chi2, status, floating, solution, minimum.chi2 / 2);
+  }
+}
@@ -0,0 +1,277 @@
+#include <NuisanceProfiler.h>
+
+#include <CharmParameters.h>
+
+#include <Combiner.h>
+
+#include <RooAbsPdf.h>
+#include <RooArgList.h>
+#include <RooArgSet.h>
+#include <RooFormulaVar.h>
+#include <RooProdPdf.h>
+#include <RooRealVar.h>
+#include <RooWorkspace.h>
+
+#include <Math/Factory.h>
+#include <Math/Functor.h>
+#include <Math/Minimizer.h>
+#include <TMatrixDSym.h>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+NuisanceProfiler::NuisanceProfiler(Combiner& combiner, const std::vector<std::string>& floating,
+                                   const std::vector<std::string>& scan_vars, const std::vector<Derived>& derived)
+    : scanVars(scan_vars) {
+  const auto& parameters = combinedParameters(combiner);
+  const auto pdf = combiner.getWorkspace()->pdf("pdf_" + combiner.getPdfName());
+  // The logs of the factors are summed, so that the product does not underflow far from the minimum
+  if (const auto product = dynamic_cast<const RooProdPdf*>(pdf)) {
+    for (const auto factor : product->pdfList()) factors.push_back(static_cast<const RooAbsPdf*>(factor));
+  } else {
+    factors.push_back(pdf);
+  }
+  for (const auto arg : parameters) {
+    const auto var = static_cast<RooRealVar*>(arg);
+    auto& par = pars[var->GetName()];
+    par.value = var->getVal();
+    par.period = CharmParameters::period(*var);
+    par.step = var->getError() > 0 ? var->getError() : 1e-3 * std::max(std::abs(var->getVal()), 1e-3);
+    par.var = var;
+  }
+  for (auto& [name, par] : pars) {
+    names.push_back(name);
+    par.floating = std::ranges::find(floating, name) != floating.end();
+    set(par, par.value);
+  }
+  for (const auto& name : scanVars) {
+    const auto it = pars.find(name);
+    if (it == pars.end()) {
+      throw std::runtime_error(
+          std::format("NuisanceProfiler::NuisanceProfiler ERROR Scanned parameter {} is not in the chi2", name));
+    }
+    it->second.floating = false;
+  }
+
+  RooArgList dependents;
+  for (const auto& name : names) dependents.add(*pars[name].var);
+  for (const auto& [name, expression] : derived) {
+    this->derived.push_back(
+        std::make_unique<RooFormulaVar>(name.c_str(), name.c_str(), expression.c_str(), dependents, false));
+    if (!this->derived.back()->ok()) {
+      throw std::runtime_error(
+          std::format("NuisanceProfiler::NuisanceProfiler ERROR Cannot evaluate {} = {}", name, expression));
+    }
+  }
+}
+
+const RooArgSet& NuisanceProfiler::combinedParameters(Combiner& combiner) {
+  if (!combiner.isCombined()) combiner.combine();
+  const auto w = combiner.getWorkspace();
+  const auto parameters = w->set("par_" + combiner.getPdfName());
+  if (!w->pdf("pdf_" + combiner.getPdfName()) || !parameters) {
+    throw std::runtime_error(std::format("NuisanceProfiler::combinedParameters ERROR Combiner {} has no combined PDF",
+                                         combiner.getName().Data()));
+  }
+  return *parameters;
+}
+
+void NuisanceProfiler::setValue(const std::string& name, const double value, const double step) {
+  const auto it = pars.find(name);
+  if (it == pars.end()) return;
+  set(it->second, value);
+  if (step > 0) it->second.step = step;
+}
+
+void NuisanceProfiler::set(Parameter& par, double value) {
+  if (par.period > 0) {
+    const auto min = par.var->getMin();
+    value -= par.period * std::floor((value - min) / par.period);
+  }
+  par.value = value;
+  par.var->setVal(value);
+}
+
+double NuisanceProfiler::chi2() const {
+  double chi2 = 0.;
+  for (const auto factor : factors) chi2 -= 2 * std::log(factor->getVal());
+  return chi2;
+}
+
+std::vector<double> NuisanceProfiler::gradient(const std::size_t k, const std::vector<Parameter*>& floating,
+                                               const std::vector<double>& steps) {
+  std::vector<double> grad;
+  for (std::size_t i = 0; i < floating.size(); ++i) {
+    const auto value = floating[i]->value;
+    const auto h = 1e-3 * steps[i];
+    if (!(h > 0)) {
+      grad.push_back(0.);
+      continue;
+    }
+    set(*floating[i], value + h);
+    const auto up = derived[k]->getVal();
+    set(*floating[i], value - h);
+    grad.push_back((up - derived[k]->getVal()) / (2 * h));
+    set(*floating[i], value);
+  }
+  return grad;
+}
+
+std::vector<std::pair<double, double>> NuisanceProfiler::derivedValues(const Result& result) {
+  std::vector<double> previous;
+  std::vector<Parameter*> all;
+  std::vector<double> errors;
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    auto& par = pars[names[i]];
+    previous.push_back(par.value);
+    set(par, result.values[i]);
+    all.push_back(&par);
+    errors.push_back(std::sqrt(std::max(result.covariance(i, i), 0.)));
+  }
+
+  std::vector<std::pair<double, double>> values;
+  for (std::size_t k = 0; k < derived.size(); ++k) {
+    const auto grad = gradient(k, all, errors);
+    double variance = 0.;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      for (std::size_t j = 0; j < names.size(); ++j) variance += grad[i] * result.covariance(i, j) * grad[j];
+    }
+    values.emplace_back(derived[k]->getVal(), std::sqrt(std::max(variance, 0.)));
+  }
+  for (std::size_t i = 0; i < names.size(); ++i) set(*all[i], previous[i]);
+  return values;
+}
+
+NuisanceProfiler::Result NuisanceProfiler::fit(const std::vector<double>& scan_values, const std::vector<double>& start,
+                                               const bool hesse) {
+  if (scan_values.size() != scanVars.size() && scan_values.size() != scanVars.size() + derived.size()) {
+    throw std::runtime_error(std::format("NuisanceProfiler::fit ERROR Expected {} or {} scan values, got {}",
+                                         scanVars.size(), scanVars.size() + derived.size(), scan_values.size()));
+  }
+  if (!start.empty() && start.size() != names.size()) {
+    throw std::runtime_error(
+        std::format("NuisanceProfiler::fit ERROR Expected {} start values, got {}", names.size(), start.size()));
+  }
+  for (std::size_t i = 0; i < start.size(); ++i) set(pars[names[i]], start[i]);
+  for (std::size_t i = 0; i < scanVars.size(); ++i) set(pars[scanVars[i]], scan_values[i]);
+
+  std::vector<Parameter*> floating;
+  for (const auto& name : names) {
+    if (pars[name].floating) floating.push_back(&pars[name]);
+  }
+  const auto num_constraints = scan_values.size() - scanVars.size();
+  Result result{{}, std::vector<double>(names.size(), 0.), 0., 0, 1, TMatrixDSym(names.size())};
+  for (const auto& name : names) result.values.push_back(pars[name].value);
+  if (floating.empty()) {
+    result.chi2 = chi2();
+    if (num_constraints > 0) result.status = -1;
+    return result;
+  }
+
+  // Penalties of the augmented Lagrangian of the constraints on the derived quantities (see NuisanceProfiler.h), with
+  // the initial weights of measurements with the precision of the scale of each quantity
+  std::vector<double> steps;
+  for (const auto par : floating) steps.push_back(par->step);
+  std::vector<double> scale, lambda(num_constraints, 0.), mu;
+  for (std::size_t k = 0; k < num_constraints; ++k) {
+    double variance = 0.;
+    const auto grad = gradient(k, floating, steps);
+    for (std::size_t i = 0; i < floating.size(); ++i) variance += std::pow(grad[i] * steps[i], 2);
+    const auto target = std::abs(scan_values[scanVars.size() + k]);
+    const auto current = std::abs(derived[k]->getVal());
+    scale.push_back(variance > 0 ? std::sqrt(variance) : target > 0 ? target : current);
+    if (!(scale.back() > 0) || !std::isfinite(scale.back())) {
+      throw std::runtime_error(std::format(
+          "NuisanceProfiler::fit ERROR Cannot set the tolerance of {} = {}: it depends on no floating parameter at the "
+          "start point, and its target and current values are zero",
+          derived[k]->GetName(), scan_values[scanVars.size() + k]));
+    }
+    mu.push_back(1 / (scale.back() * scale.back()));
+  }
+  const auto deviation = [this, &scan_values](const std::size_t k) {
+    return derived[k]->getVal() - scan_values[scanVars.size() + k];
+  };
+
+  const auto function = [this, &floating, &lambda, &mu, &deviation](const double* x) {
+    for (std::size_t i = 0; i < floating.size(); ++i) set(*floating[i], x[i]);
+    auto value = chi2();
+    for (std::size_t k = 0; k < lambda.size(); ++k) {
+      const auto g = deviation(k);
+      value += lambda[k] * g + mu[k] * g * g;
+    }
+    return value;
+  };
+  ROOT::Math::Functor functor(function, floating.size());
+
+  const auto minimizer = std::unique_ptr<ROOT::Math::Minimizer>(ROOT::Math::Factory::CreateMinimizer("Minuit2"));
+  minimizer->SetFunction(functor);
+  minimizer->SetPrintLevel(-1);
+  minimizer->SetMaxFunctionCalls(100000);
+  for (std::size_t i = 0; i < floating.size(); ++i) {
+    const auto var = floating[i]->var;
+    if (var->hasMin() && var->hasMax() && floating[i]->period == 0) {
+      const auto value = std::clamp(floating[i]->value, var->getMin(), var->getMax());
+      minimizer->SetLimitedVariable(i, var->GetName(), value, floating[i]->step, var->getMin(), var->getMax());
+    } else {
+      minimizer->SetVariable(i, var->GetName(), floating[i]->value, floating[i]->step);
+    }
+  }
+  minimizer->Minimize();
+  // Each minimisation counts its own calls
+  auto ncalls = minimizer->NCalls();
+
+  // Move the multipliers until the derived quantities reach their values, stiffening the constraints that converge
+  // slowly. Each minimisation starts from the previous minimum.
+  bool constraints_met = true;
+  std::vector<double> previous(num_constraints, std::numeric_limits<double>::infinity());
+  for (int iter = 0; num_constraints > 0; ++iter) {
+    const auto x = minimizer->X();
+    for (std::size_t i = 0; i < floating.size(); ++i) set(*floating[i], x[i]);
+    bool met = true;
+    for (std::size_t k = 0; k < num_constraints; ++k) met = met && std::abs(deviation(k)) <= 1e-4 * scale[k];
+    if (met || iter == 20) {
+      constraints_met = met;
+      break;
+    }
+    for (std::size_t k = 0; k < num_constraints; ++k) {
+      const auto g = deviation(k);
+      lambda[k] += 2 * mu[k] * g;
+      if (std::abs(g) > 0.25 * previous[k]) mu[k] *= 10;
+      previous[k] = std::abs(g);
+    }
+    minimizer->Minimize();
+    ncalls += minimizer->NCalls();
+  }
+  if (hesse) minimizer->Hesse();
+
+  // Leave the parameters at the minimum, as the start of the next fit
+  const auto x = minimizer->X();
+  for (std::size_t i = 0; i < floating.size(); ++i) set(*floating[i], x[i]);
+
+  result.chi2 = chi2();
+  result.status = constraints_met ? minimizer->Status() : -1;
+  result.ncalls = static_cast<int>(ncalls);
+  const auto errors = minimizer->Errors();
+  std::vector<int> index(names.size(), -1);  // Index of each parameter in the minimizer
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    result.values[i] = pars[names[i]].value;
+    const auto it = std::ranges::find(floating, &pars[names[i]]);
+    if (it != floating.end()) index[i] = it - floating.begin();
+    if (index[i] >= 0 && errors) result.errors[i] = errors[index[i]];
+  }
+  if (hesse) {
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      for (std::size_t j = 0; j < names.size(); ++j) {
+        if (index[i] >= 0 && index[j] >= 0) result.covariance(i, j) = minimizer->CovMatrix(index[i], index[j]);
+      }
+    }
+  }
+  return result;
+}
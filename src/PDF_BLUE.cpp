@@ -0,0 +1,93 @@
+/**
+ * Charm Combination
+ * Author: tommaso.pajero@cern.ch
+ * Date: October 2026
+ **/
+
+#include <PDF_BLUE.h>
+
+#include <Utils.h>
+
+#include <BLUE/Utils.h>
+
+#include <RooRealVar.h>
+
+#include <TMatrixDSym.h>
+#include <TString.h>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+PDF_BLUE::PDF_BLUE(const TString measurement_id, const BLUE::Inputs& inputs, const int flag, const double unit,
+                   const std::vector<Observable>& observables, std::set<std::string> parameter_names)
+    : PDF_Charm{static_cast<int>(observables.size())}, average{BLUE::average(inputs, flag)}, unit{unit},
+      parameterNames{std::move(parameter_names)}, measurement_id{measurement_id} {
+  name = "BLUE_" + measurement_id;
+  if (average.observables.size() != observables.size()) {
+    throw std::runtime_error(std::format("PDF_BLUE::PDF_BLUE ERROR combination {} averages {} observables, got {}",
+                                         flag, average.observables.size(), observables.size()));
+  }
+  for (const auto& blue_name : average.observables) {
+    const auto it = std::ranges::find(observables, blue_name, &Observable::blue_name);
+    if (it == observables.end()) {
+      throw std::runtime_error(
+          std::format("PDF_BLUE::PDF_BLUE ERROR no theory prediction for observable {} of combination {}", blue_name,
+                      flag));
+    }
+    observables_th.push_back(*it);
+  }
+  initialise(measurement_id, measurement_id, measurement_id);
+}
+
+std::set<std::string> PDF_BLUE::getParameterNames() const { return parameterNames; }
+
+void PDF_BLUE::initRelations() {
+  theory = new RooArgList("theory");
+  for (const auto& obs : observables_th)
+    theory->add(*(Utils::makeTheoryVar(obs.name + "_th", obs.expression, parameters)));
+}
+
+void PDF_BLUE::initObservables() {
+  observables = new RooArgList("observables");
+  for (const auto& obs : observables_th)
+    observables->add(*(new RooRealVar((obs.name + "_obs").c_str(), measurement_id + "   " + obs.title, 0, -1e4, 1e4)));
+}
+
+void PDF_BLUE::setObservables(const TString c) {
+  obsValSource = "BLUE average " + measurement_id + ", solved in-process";
+  if (c.EqualTo("truth"))
+    setObservablesTruth();
+  else if (c.EqualTo("toy"))
+    setObservablesToy();
+  else {
+    for (int i = 0; i < nObs; ++i) setObservable(TString(observables_th[i].name + "_obs"), average.values[i] * unit);
+  }
+}
+
+void PDF_BLUE::setUncertainties(const TString c) {
+  obsErrSource = "BLUE average " + measurement_id + ", solved in-process";
+  for (int i = 0; i < nObs; ++i) {
+    StatErr[i] = std::sqrt(average.cov_stat(i, i)) * unit;
+    SystErr[i] = std::sqrt(average.cov_syst(i, i)) * unit;
+  }
+}
+
+void PDF_BLUE::setCorrelations(const TString c) {
+  resetCorrelations();
+  corSource = "BLUE average " + measurement_id + ", solved in-process";
+  const auto correlation = [](const TMatrixDSym& cov, const int i, const int j) {
+    const auto norm = std::sqrt(cov(i, i) * cov(j, j));
+    return norm > 0 ? cov(i, j) / norm : 0.;
+  };
+  for (int i = 0; i < nObs; ++i) {
+    for (int j = 0; j < i; ++j) {
+      corStatMatrix[i][j] = corStatMatrix[j][i] = correlation(average.cov_stat, i, j);
+      corSystMatrix[i][j] = corSystMatrix[j][i] = correlation(average.cov_syst, i, j);
+    }
+  }
+}
@@ -3,13 +3,18 @@
 #include <CharmParameters.h>
 
 #include <RooArgList.h>
+#include <RooFormulaVar.h>
 #include <RooMultiVarGaussian.h>
 #include <RooRealVar.h>
 
+#include <TMatrixDSym.h>
 #include <TString.h>
 
 #include <format>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 void PDF_Charm::initParameters() {
   CharmParameters p;
@@ -42,3 +47,53 @@ void PDF_Charm::initialise(const TString val_id, const TString unc_id, const TSt
   else
     buildPdf();
 }
+
+std::string PDF_Charm::fingerprint() const {
+  std::ostringstream out;
+  out.precision(17);
+  const auto print_matrix = [&out](const char* label, const TMatrixDSym& m) {
+    out << label << ":";
+    for (int i = 0; i < m.GetNrows(); ++i)
+      for (int j = 0; j <= i; ++j) out << " " << m(i, j);
+    out << ";";
+  };
+
+  out << name << ";";
+  for (const auto obs : *observables) out << obs->GetName() << "=" << static_cast<RooRealVar*>(obs)->getVal() << ";";
+  for (const auto th : *theory) {
+    const auto formula = dynamic_cast<RooFormulaVar*>(th);
+    out << th->GetName() << "=" << (formula ? formula->expression() : th->ClassName()) << ";";
+  }
+  out << "stat:";
+  for (const auto err : StatErr) out << " " << err;
+  out << ";syst:";
+  for (const auto err : SystErr) out << " " << err;
+  out << ";";
+  print_matrix("corStat", corStatMatrix);
+  print_matrix("corSyst", corSystMatrix);
+  print_matrix("cov", covMatrix);
+  return out.str();
+}
+
+TMatrixDSym PDF_Charm::covariance(const std::vector<double>& stat_scale, const std::vector<double>& syst_scale) const {
+  if (stat_scale.size() != static_cast<std::size_t>(nObs) || syst_scale.size() != static_cast<std::size_t>(nObs)) {
+    throw std::runtime_error(std::format("PDF_Charm::covariance ERROR Expected {} scale factors", nObs));
+  }
+  TMatrixDSym cov(nObs);
+  for (int i = 0; i < nObs; ++i) {
+    for (int j = 0; j < nObs; ++j) {
+      const auto stat = corStatMatrix(i, j) * StatErr[i] * StatErr[j];
+      cov(i, j) = stat_scale[i] * stat_scale[j] * stat + syst_scale[i] * syst_scale[j] * (covMatrix(i, j) - stat);
+    }
+  }
+  return cov;
+}
+
+void PDF_Charm::scaleUncertainties(const std::vector<double>& stat_scale, const std::vector<double>& syst_scale) {
+  covMatrix = covariance(stat_scale, syst_scale);
+  for (int i = 0; i < nObs; ++i) {
+    StatErr[i] *= stat_scale[i];
+    SystErr[i] *= syst_scale[i];
+  }
+  buildPdf();
+}
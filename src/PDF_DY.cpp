@@ -10,13 +10,40 @@
 
 #include <Utils.h>
 
+#ifdef CHARM_FITTER_WITH_BLUE
+#include <BLUE/DY.h>
+#include <BLUE/Utils.h>
+#endif
+
 #include <RooFormulaVar.h>
 #include <RooRealVar.h>
 
+#include <algorithm>
+#include <cmath>
 #include <format>
 #include <iostream>
 #include <stdexcept>
 
+#ifdef CHARM_FITTER_WITH_BLUE
+namespace {
+  /// Correlation of the systematic uncertainties of DY(KK) and DY(PP) in the combination `flag` of BLUE/src/DY.cpp.
+  double blue_syst_correlation(const int flag) {
+    const auto average = BLUE::average(BLUE::dy::inputs(), flag);
+    const auto index = [&average, flag](const std::string& name) {
+      const auto it = std::ranges::find(average.observables, name);
+      if (it == average.observables.end()) {
+        throw std::runtime_error(
+            std::format("PDF_DY::setCorrelations ERROR BLUE combination {} does not average {}", flag, name));
+      }
+      return static_cast<int>(it - average.observables.begin());
+    };
+    const auto kk = index("DY(KK)");
+    const auto pp = index("DY(PP)");
+    return average.cov_syst(kk, pp) / std::sqrt(average.cov_syst(kk, kk) * average.cov_syst(pp, pp));
+  }
+}  // namespace
+#endif
+
 PDF_DY::PDF_DY(const TString measurement_id, const hypotheses::dy_fsc dy_fsc_hypo,
                const parametrisations::acp acp_param, const parametrisations::mix mix_param)
     : PDF_Charm{dy_fsc_hypo == hypotheses::dy_fsc::none ? 1 : 2}, dy_fsc_hypo{dy_fsc_hypo}, acp_param{acp_param},
@@ -108,12 +135,23 @@ void PDF_DY::setUncertainties(const TString c) {
 void PDF_DY::setCorrelations(const TString c) {
   resetCorrelations();
   corSource = "https://github.com/tpajero/charm-fitter/tree/master/charmcombo/blue/DY.cpp";
+  // The correlations of the systematic uncertainties follow from the averages of DY(KK) and DY(PP) with their full
+  // correlation matrix, combinations 110 (WA2020) and 111 (WA2021) of BLUE/src/DY.cpp. They are solved in-process when
+  // BLUE is built, and otherwise copied from its output.
+#ifdef CHARM_FITTER_WITH_BLUE
+  const auto correlation = [](const int flag, double) { return blue_syst_correlation(flag); };
+  if (nObs == 2) corSource = "BLUE combinations 110 (WA2020) and 111 (WA2021), solved in-process";
+#else
+  const auto correlation = [](int, const double copied) { return copied; };
+#endif
   if (nObs == 1)
     corSource = "No correlations for one observable";
+  // np.sum(np.square([0.05, 0.42, 0.10, 0.04, 0.23, 0.09])) / 0.57 / 0.70
   else if (nObs == 2 && c.EqualTo("WA2020"))
-    corSystMatrix[0][1] = 0.63;  // np.sum(np.square([0.05, 0.42, 0.10, 0.04, 0.23, 0.09])) / 0.57 / 0.70
+    corSystMatrix[0][1] = correlation(110, 0.63);
+  // np.sum(np.square([0.18, 0.21, 0.06, 0.01, 0.07])) / 0.32 / 0.39
   else if (nObs == 2 && c.EqualTo("WA2021"))
-    corSystMatrix[0][1] = 0.68;  // np.sum(np.square([0.18, 0.21, 0.06, 0.01, 0.07])) / 0.32 / 0.39
+    corSystMatrix[0][1] = correlation(111, 0.68);
   else {
     throw std::runtime_error(
         std::format("PDF_DY::setCorrelations ERROR config {} not found for {} DY observables", c.Data(), nObs));
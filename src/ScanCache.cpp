@@ -0,0 +1,83 @@
+#include <ScanCache.h>
+
+#include <PDF_Charm.h>
+
+#include <Combiner.h>
+#include <GammaComboEngine.h>
+#include <PDF_Abs.h>
+
+#include <RVersion.h>
+
+#include <dlfcn.h>
+
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+
+namespace {
+  /// PDF and combiner ids are looked up in [0, max_id).
+  constexpr int max_id = 1000;
+
+  /// Path of the executable or shared library that holds `address`.
+  std::string binary_path(const void* address) {
+    Dl_info info;
+    if (!dladdr(address, &info) || !info.dli_fname) {
+      throw std::runtime_error("scan_cache::build_id ERROR Cannot find the library holding the fit");
+    }
+    return info.dli_fname;
+  }
+
+  /// 64-bit FNV-1a hash of the contents of a file, which is stable across runs and builds.
+  std::uint64_t hash_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error(std::format("scan_cache::build_id ERROR Cannot read {}", path));
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for (auto it = std::istreambuf_iterator<char>(in); it != std::istreambuf_iterator<char>(); ++it) {
+      hash = (hash ^ static_cast<unsigned char>(*it)) * 0x100000001b3;
+    }
+    return hash;
+  }
+}  // namespace
+
+std::string scan_cache::build_id() {
+  static const auto id = [] {
+    // The fitter library holds this function, and the GammaCombo library the type information of PDF_Abs
+    const std::set<std::string> binaries{binary_path(reinterpret_cast<const void*>(&scan_cache::build_id)),
+                                         binary_path(&typeid(PDF_Abs))};
+    std::string hashes;
+    for (const auto& binary : binaries) {
+      hashes += std::format("{}{:016x}", hashes.empty() ? "" : "-", hash_file(binary));
+    }
+    return hashes;
+  }();
+  return id;
+}
+
+void scan_cache::print_fingerprints(GammaComboEngine& gc, const std::string& engine_name) {
+  std::cout << std::format("FINGERPRINT {} version {} ROOT-{}\n", engine_name, build_id(), ROOT_RELEASE);
+  for (int id = 0; id < max_id; ++id) {
+    if (!gc.pdfExists(id)) continue;
+    const auto pdf = dynamic_cast<const PDF_Charm*>(gc.getPdf(id));
+    if (!pdf) {
+      throw std::runtime_error(
+          std::format("scan_cache::print_fingerprints ERROR PDF {} does not inherit from PDF_Charm", id));
+    }
+    std::cout << std::format("FINGERPRINT {} pdf {} {}\n", engine_name, id, pdf->fingerprint());
+  }
+  for (int id = 0; id < max_id; ++id) {
+    if (!gc.combinerExists(id)) continue;
+    std::string pdf_ids;
+    for (const auto pdf : gc.getCombiner(id)->getPdfs()) {
+      if (!pdf_ids.empty()) pdf_ids += ",";
+      pdf_ids += std::to_string(pdf->getGcId());
+    }
+    std::cout << std::format("FINGERPRINT {} combiner {} {}\n", engine_name, id, pdf_ids);
+  }
+  std::cout << std::flush;
+}
@@ -0,0 +1,433 @@
+#include <ScanColumns.h>
+
+#include <IoUtils.h>
+#include <NuisanceProfiler.h>
+#include <PDF_Charm.h>
+
+#include <Combiner.h>
+#include <GammaComboEngine.h>
+#include <RooSlimFitResult.h>
+
+#include <RooArgList.h>
+#include <RooRealVar.h>
+#include <TFile.h>
+#include <TH1.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+  static_assert(std::endian::native == std::endian::little, "The columns are written as little-endian numbers");
+
+  const fs::path scanner_dir = "plots/scanner";
+  const fs::path columns_dir = "plots/columns";
+  /// Clones of the combiners are given the first free id from here on.
+  constexpr int clone_id = 1000;
+
+  /// Column of numbers in C order.
+  template <typename T>
+  struct Column {
+    std::vector<std::size_t> shape;
+    std::vector<T> values;
+  };
+
+  template <typename T>
+  std::string npy_header(const std::vector<std::size_t>& shape) {
+    static_assert(std::is_same_v<T, double> || std::is_same_v<T, std::int32_t>);
+    std::string shape_str;
+    for (const auto n : shape) shape_str += std::format("{}, ", n);
+    if (shape.size() > 1) shape_str.resize(shape_str.size() - 2);
+    auto dict = std::format("{{'descr': '{}', 'fortran_order': False, 'shape': ({}), }}",
+                            std::is_same_v<T, double> ? "<f8" : "<i4", shape_str);
+    // The magic string, version and header length take 10 bytes, and the data must be aligned to 64 bytes
+    dict.append(63 - (10 + dict.size()) % 64, ' ');
+    dict += '\n';
+    const auto len = static_cast<std::uint16_t>(dict.size());
+    return std::string("\x93NUMPY\x01\x00", 8) + static_cast<char>(len & 0xff) + static_cast<char>(len >> 8) + dict;
+  }
+
+  /// Read a column written by `write_column`, if it exists and has the given shape.
+  template <typename T>
+  std::optional<std::vector<T>> read_column(const fs::path& path, const std::vector<std::size_t>& shape) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return std::nullopt;
+    const std::string content{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    const auto header = npy_header<T>(shape);
+    std::size_t size = 1;
+    for (const auto n : shape) size *= n;
+    if (content.size() != header.size() + size * sizeof(T) || !content.starts_with(header)) return std::nullopt;
+    std::vector<T> values(size);
+    std::memcpy(values.data(), content.data() + header.size(), size * sizeof(T));
+    return values;
+  }
+
+  /// Write a column, then read it back and check that it is bit-by-bit identical to the original.
+  template <typename T>
+  void write_column(const fs::path& path, const Column<T>& column) {
+    std::ofstream out(path, std::ios::binary);
+    const auto header = npy_header<T>(column.shape);
+    out.write(header.data(), header.size());
+    out.write(reinterpret_cast<const char*>(column.values.data()), column.values.size() * sizeof(T));
+    out.close();
+    if (!out) throw std::runtime_error(std::format("scan_columns::convert ERROR Cannot write {}", path.string()));
+
+    const auto values = read_column<T>(path, column.shape);
+    if (!values || std::memcmp(values->data(), column.values.data(), column.values.size() * sizeof(T))) {
+      throw std::runtime_error(
+          std::format("scan_columns::convert ERROR {} does not round-trip with the scanner file", path.string()));
+    }
+  }
+
+  /// Read back a list of strings written by `io::json_list` on its own line of meta.json.
+  std::vector<std::string> read_meta_list(const fs::path& path, const std::string& key) {
+    std::ifstream in(path);
+    const auto prefix = std::format("  {}: [", io::json_string(key));
+    for (std::string line; std::getline(in, line);) {
+      if (!line.starts_with(prefix)) continue;
+      std::vector<std::string> items;
+      for (auto pos = line.find('"', prefix.size()); pos != std::string::npos;) {
+        const auto end = line.find('"', pos + 1);
+        items.push_back(line.substr(pos + 1, end - pos - 1));
+        pos = line.find('"', end + 1);
+      }
+      return items;
+    }
+    return {};
+  }
+
+  /// Profile of all parameters along the grid of a scan (see NuisanceProfiler).
+  struct NuisanceTable {
+    std::vector<std::string> names;
+    Column<double> nuisances;
+    Column<double> chi2;
+    Column<std::int32_t> status;
+    Column<std::int32_t> ncalls;
+  };
+
+  /**
+   * Refit the chi2 of the combiner at each point of the grid, with the floating parameters of the global fit of the
+   * scan (or else all those that are neither constant nor fixed by --fix), and the others at the values of GammaCombo.
+   */
+  NuisanceTable profile_nuisances(Combiner& combiner, const std::vector<std::string>& scan_vars,
+                                  const std::map<std::string, double>& fixed,
+                                  const std::vector<std::vector<double>>& axes, const std::vector<double>& chi2min,
+                                  const RooSlimFitResult* best_fit, const fs::path& out_dir) {
+    std::vector<std::string> floating;
+    if (best_fit) {
+      for (const auto par : best_fit->floatParsFinal()) floating.push_back(par->GetName());
+    } else {
+      for (const auto par : NuisanceProfiler::combinedParameters(combiner)) {
+        if (!static_cast<RooRealVar*>(par)->isConstant()) floating.push_back(par->GetName());
+      }
+    }
+    std::erase_if(floating, [&fixed](const std::string& name) { return fixed.contains(name); });
+    NuisanceProfiler profiler(combiner, floating, scan_vars);
+    if (best_fit) {
+      for (const auto par : best_fit->constPars()) {
+        profiler.setValue(par->GetName(), static_cast<RooRealVar*>(par)->getVal());
+      }
+      for (const auto par : best_fit->floatParsFinal()) {
+        const auto var = static_cast<RooRealVar*>(par);
+        profiler.setValue(var->GetName(), var->getVal(), var->getError());
+      }
+    }
+    for (const auto& [name, value] : fixed) profiler.setValue(name, value);
+
+    NuisanceTable table;
+    table.names = profiler.parameters();
+    const std::size_t nx = axes[0].size();
+    const std::size_t ny = axes.size() > 1 ? axes[1].size() : 1;
+    const auto grid_shape = axes.size() > 1 ? std::vector{nx, ny} : std::vector{nx};
+    auto shape = grid_shape;
+    shape.push_back(table.names.size());
+    table.nuisances = {shape, std::vector<double>(nx * ny * table.names.size())};
+    table.chi2 = {grid_shape, std::vector<double>(nx * ny)};
+    table.status = {grid_shape, std::vector<std::int32_t>(nx * ny)};
+    table.ncalls = {grid_shape, std::vector<std::int32_t>(nx * ny)};
+
+    // Warm start from the previous run, if it used the same grid and parameters
+    std::optional<std::vector<double>> previous;
+    if (read_meta_list(out_dir / "meta.json", "nuisance_parameters") == table.names &&
+        read_column<double>(out_dir / "x.npy", {nx}) == axes[0] &&
+        (axes.size() == 1 || read_column<double>(out_dir / "y.npy", {ny}) == axes[1])) {
+      previous = read_column<double>(out_dir / "nuisances.npy", shape);
+    }
+    if (previous) std::cout << "INFO scan_columns::convert: starting from the parameters in " << out_dir << std::endl;
+
+    // Snake through the grid, so that each point starts from a neighbouring one
+    const auto npars = table.names.size();
+    for (std::size_t i = 0; i < nx; ++i) {
+      for (std::size_t k = 0; k < ny; ++k) {
+        const auto j = i % 2 ? ny - 1 - k : k;
+        const auto point = i * ny + j;
+        std::vector<double> scan_values = {axes[0][i]};
+        if (axes.size() > 1) scan_values.push_back(axes[1][j]);
+        std::vector<double> start;
+        if (previous) start.assign(previous->begin() + point * npars, previous->begin() + (point + 1) * npars);
+
+        const auto result = profiler.fit(scan_values, start);
+        std::ranges::copy(result.values, table.nuisances.values.begin() + point * npars);
+        table.chi2.values[point] = result.chi2;
+        table.status.values[point] = result.status;
+        table.ncalls.values[point] = result.ncalls;
+      }
+    }
+
+    // The refits minimise the same chi2 as the scan, so they should find the same minima
+    std::size_t differ = 0;
+    double max_diff = 0.;
+    for (std::size_t point = 0; point < chi2min.size(); ++point) {
+      const auto diff = std::abs(table.chi2.values[point] - chi2min[point]);
+      if (table.status.values[point] == 0 && diff > 1e-2) ++differ;
+      if (table.status.values[point] == 0) max_diff = std::max(max_diff, diff);
+    }
+    if (differ > 0) {
+      std::cout << std::format("INFO scan_columns::convert: the refits of {} of {} points differ from the chi2 of the "
+                               "scan by more than 0.01 (at most {:.3g})\n",
+                               differ, chi2min.size(), max_diff);
+    }
+    return table;
+  }
+
+  /**
+   * Write the columns and meta.json of a scan to `out_dir`.
+   *
+   * @param status Status of the fit at each point of a scan computed without GammaCombo, if any.
+   */
+  void write_scan(const fs::path& out_dir, const std::string& source, const std::vector<std::string>& axis_titles,
+                  const std::vector<std::pair<std::string, Column<double>>>& columns,
+                  const std::vector<std::string>& par_names, const std::vector<std::string>& solution_min_nll,
+                  const std::optional<NuisanceTable>& table, const std::optional<Column<std::int32_t>>& status) {
+    fs::create_directories(out_dir);
+    std::vector<std::string> column_names;
+    for (const auto& [name, column] : columns) {
+      write_column(out_dir / (name + ".npy"), column);
+      column_names.push_back(name);
+    }
+    if (status) {
+      write_column(out_dir / "status.npy", *status);
+      column_names.push_back("status");
+    }
+    if (table) {
+      write_column(out_dir / "nuisances.npy", table->nuisances);
+      write_column(out_dir / "chi2.npy", table->chi2);
+      write_column(out_dir / "status.npy", table->status);
+      write_column(out_dir / "ncalls.npy", table->ncalls);
+      column_names.insert(column_names.end(), {"nuisances", "chi2", "status", "ncalls"});
+    }
+
+    std::ofstream meta(out_dir / "meta.json");
+    meta << "{\n"
+         << "  \"version\": " << scan_columns::version << ",\n"
+         << "  \"source\": " << io::json_string(source) << ",\n"
+         << "  \"dimension\": " << axis_titles.size() << ",\n"
+         << "  \"axis_titles\": " << io::json_list(axis_titles, io::json_string) << ",\n"
+         << "  \"columns\": " << io::json_list(column_names, io::json_string) << ",\n"
+         << "  \"parameters\": " << io::json_list(par_names, io::json_string) << ",\n"
+         << "  \"solution_min_nll\": [" << (solution_min_nll.empty() ? "" : solution_min_nll.front());
+    for (std::size_t i = 1; i < solution_min_nll.size(); ++i) meta << ", " << solution_min_nll[i];
+    meta << "],\n"
+         << "  \"nuisance_parameters\": "
+         << io::json_list(table ? table->names : std::vector<std::string>{}, io::json_string) << "\n"
+         << "}\n";
+    if (!meta) {
+      throw std::runtime_error(std::format("scan_columns::convert ERROR Cannot write {}/meta.json", out_dir.string()));
+    }
+    std::cout << "INFO scan_columns::convert: written " << out_dir << std::endl;
+  }
+}  // namespace
+
+scan_columns::Options scan_columns::parse_options(int& argc, char* argv[]) {
+  Options options;
+  options.save_nuisances = io::parse_flag(argc, argv, "--save-nuisances");
+  const std::vector<char*> args(argv, argv + argc);
+  options.combiners = io::option_values(args, "-c");
+  options.vars = io::option_values(args, "--var");
+  options.fixed = io::fixed_values(args);
+  return options;
+}
+
+std::optional<scan_columns::SelectedCombiner> scan_columns::resolve_combiner(GammaComboEngine& gc,
+                                                                              const std::string& arg) {
+  const auto colon = arg.find(':');
+  auto id = std::stoi(arg.substr(0, colon));
+  if (!gc.combinerExists(id)) return std::nullopt;
+  std::string name = gc.getCombiner(id)->getName().Data();
+  std::vector<int> added;
+  if (colon != std::string::npos) {
+    std::stringstream modifications(arg.substr(colon + 1));
+    for (std::string pdf_id; std::getline(modifications, pdf_id, ',');) {
+      // Only added PDFs are supported, which is what the Python driver uses
+      if (!pdf_id.starts_with('+') || !gc.pdfExists(std::stoi(pdf_id.substr(1)))) return std::nullopt;
+      name += pdf_id;
+      added.push_back(std::stoi(pdf_id.substr(1)));
+    }
+  }
+
+  std::vector<const PDF_Charm*> charm_pdfs;
+  auto pdfs = gc.getCombiner(id)->getPdfs();
+  for (const auto pdf_id : added) pdfs.push_back(gc.getPdf(pdf_id));
+  for (const auto pdf : pdfs) {
+    const auto charm_pdf = dynamic_cast<const PDF_Charm*>(pdf);
+    if (!charm_pdf) return std::nullopt;
+    if (std::ranges::find(charm_pdfs, charm_pdf) == charm_pdfs.end()) charm_pdfs.push_back(charm_pdf);
+  }
+
+  // The PDFs are added to a clone, which is combined anew
+  if (!added.empty()) {
+    id = clone_combiner(gc, id);
+    for (const auto pdf_id : added) gc.getCombiner(id)->addPdf(gc[pdf_id]);
+  }
+  return SelectedCombiner{name, id, charm_pdfs};
+}
+
+int scan_columns::clone_combiner(GammaComboEngine& gc, const int id) {
+  auto clone = clone_id;
+  while (gc.combinerExists(clone)) ++clone;
+  gc.cloneCombiner(clone, id, std::format("{}_{}", gc.getCombiner(id)->getName().Data(), clone),
+                   gc.getCombiner(id)->getTitle());
+  return clone;
+}
+
+void scan_columns::convert(const fs::path& scanner_file, Combiner* combiner, const std::vector<std::string>& scan_vars,
+                           const std::map<std::string, double>& fixed) {
+  const auto file = std::unique_ptr<TFile>(TFile::Open(scanner_file.c_str(), "READ"));
+  if (!file || file->IsZombie()) {
+    throw std::runtime_error(std::format("scan_columns::convert ERROR Cannot open {}", scanner_file.string()));
+  }
+  const auto h_cl = dynamic_cast<TH1*>(file->Get("hCL"));
+  const auto h_chi2 = dynamic_cast<TH1*>(file->Get("hChi2min"));
+  if (!h_cl || !h_chi2) {
+    std::cout << "INFO scan_columns::convert: skipping " << scanner_file << " (no hCL or hChi2min histogram)"
+              << std::endl;
+    return;
+  }
+
+  const bool is_2d = h_cl->GetDimension() == 2;
+  const std::size_t nx = h_cl->GetNbinsX();
+  const std::size_t ny = is_2d ? h_cl->GetNbinsY() : 1;
+  const auto grid_shape = is_2d ? std::vector{nx, ny} : std::vector{nx};
+  std::vector<std::pair<std::string, Column<double>>> columns;
+  std::vector<std::vector<double>> axes;
+
+  columns.emplace_back("x", Column<double>{{nx}, {}});
+  for (std::size_t i = 1; i <= nx; ++i) columns.back().second.values.push_back(h_cl->GetXaxis()->GetBinCenter(i));
+  axes.push_back(columns.back().second.values);
+  if (is_2d) {
+    columns.emplace_back("y", Column<double>{{ny}, {}});
+    for (std::size_t j = 1; j <= ny; ++j) columns.back().second.values.push_back(h_cl->GetYaxis()->GetBinCenter(j));
+    axes.push_back(columns.back().second.values);
+  }
+  for (const auto& [name, h] : {std::pair{"cl", h_cl}, std::pair{"chi2min", h_chi2}}) {
+    columns.emplace_back(name, Column<double>{grid_shape, {}});
+    for (std::size_t i = 1; i <= nx; ++i) {
+      for (std::size_t j = 1; j <= ny; ++j) {
+        columns.back().second.values.push_back(is_2d ? h->GetBinContent(i, j) : h->GetBinContent(i));
+      }
+    }
+  }
+
+  // Local minima, saved by GammaCombo as sol0, sol1, ...
+  std::vector<std::string> par_names;
+  std::vector<std::string> solution_min_nll;
+  Column<double> solutions;
+  for (int i = 0;; ++i) {
+    const auto sol = dynamic_cast<RooSlimFitResult*>(file->Get(std::format("sol{}", i).c_str()));
+    if (!sol) break;
+    const auto& pars = sol->floatParsFinal();
+    if (i == 0) {
+      for (const auto par : pars) par_names.push_back(par->GetName());
+    } else if (static_cast<std::size_t>(pars.getSize()) != par_names.size()) {
+      throw std::runtime_error(std::format(
+          "scan_columns::convert ERROR Solutions in {} have different parameters", scanner_file.string()));
+    }
+    for (const auto par : pars) solutions.values.push_back(static_cast<const RooRealVar*>(par)->getVal());
+    solution_min_nll.push_back(std::format("{}", sol->minNll()));
+  }
+  solutions.shape = {solution_min_nll.size(), par_names.size()};
+  columns.emplace_back("solutions", std::move(solutions));
+
+  const auto out_dir = columns_dir / scanner_file.stem();
+  std::optional<NuisanceTable> table;
+  if (combiner) {
+    const auto chi2min = std::ranges::find_if(columns, [](const auto& c) { return c.first == "chi2min"; });
+    table = profile_nuisances(*combiner, scan_vars, fixed, axes, chi2min->second.values,
+                              dynamic_cast<RooSlimFitResult*>(file->Get("sol0")), out_dir);
+  }
+
+  std::vector<std::string> axis_titles = {h_cl->GetXaxis()->GetTitle()};
+  if (is_2d) axis_titles.push_back(h_cl->GetYaxis()->GetTitle());
+  write_scan(out_dir, scanner_file.string(), axis_titles, columns, par_names, solution_min_nll, table, std::nullopt);
+}
+
+void scan_columns::write(const std::string& name, const std::string& source,
+                         const std::vector<std::string>& axis_titles, const std::vector<std::vector<double>>& axes,
+                         const std::vector<double>& cl, const std::vector<double>& chi2min,
+                         const std::vector<int>& status, const std::vector<std::string>& parameters,
+                         const std::vector<double>& solution, const double min_nll) {
+  std::vector<std::size_t> grid_shape;
+  std::vector<std::pair<std::string, Column<double>>> columns;
+  for (std::size_t i = 0; i < axes.size(); ++i) {
+    grid_shape.push_back(axes[i].size());
+    columns.emplace_back(i == 0 ? "x" : "y", Column<double>{{axes[i].size()}, axes[i]});
+  }
+  columns.emplace_back("cl", Column<double>{grid_shape, cl});
+  columns.emplace_back("chi2min", Column<double>{grid_shape, chi2min});
+  columns.emplace_back("solutions", Column<double>{{1, parameters.size()}, solution});
+  std::optional<Column<std::int32_t>> status_column;
+  if (!status.empty()) status_column = Column<std::int32_t>{grid_shape, {status.begin(), status.end()}};
+  write_scan(columns_dir / name, source, axis_titles, columns, parameters, {std::format("{}", min_nll)}, std::nullopt,
+             status_column);
+}
+
+void scan_columns::convert_new(GammaComboEngine& gc, const std::string& engine_name, fs::file_time_type since,
+                               const Options& options) {
+  if (!fs::is_directory(scanner_dir)) return;
+
+  // Scanner files are named <engine_name>_scanner_<combiner_name>_<var1>[_<var2>].root
+  std::string vars;
+  for (const auto& var : options.vars) vars += "_" + var;
+  std::vector<SelectedCombiner> combiners;
+  if (options.save_nuisances) {
+    for (const auto& arg : options.combiners) {
+      if (auto combiner = resolve_combiner(gc, arg)) {
+        combiners.push_back(std::move(*combiner));
+      } else {
+        std::cout << "INFO scan_columns::convert_new: cannot save the nuisance parameters of combiner " << arg
+                  << std::endl;
+      }
+    }
+  }
+
+  for (const auto& entry : fs::directory_iterator(scanner_dir)) {
+    const auto& path = entry.path();
+    if (path.extension() != ".root" || !path.filename().string().starts_with(engine_name + "_")) continue;
+    if (entry.last_write_time() < since) continue;
+    const auto combiner = std::ranges::find_if(combiners, [&](const auto& c) {
+      return path.stem().string() == std::format("{}_scanner_{}{}", engine_name, c.name, vars);
+    });
+    if (combiner != combiners.end())
+      convert(path, gc.getCombiner(combiner->id), options.vars, options.fixed);
+    else
+      convert(path);
+  }
+}
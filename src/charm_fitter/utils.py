@@ -1,13 +1,16 @@
 import argparse
+import hashlib
 import importlib
+import json
 import os
 import re
 import subprocess
+import tempfile
+import time
 from collections.abc import Callable
 from contextlib import contextmanager
 from dataclasses import KW_ONLY, dataclass, field
 from enum import Enum
-from multiprocessing import Pool
 from pathlib import Path
 from types import ModuleType
 from typing import Any
@@ -28,6 +31,11 @@ from matplotlib.ticker import MaxNLocator
 from scipy.stats import chi2
 
 repo_path = Path(__file__).resolve().parents[2]
+# Bookkeeping files of the scan driver, relative to the directory the executables are run from
+scan_history_path = Path("plots/scan-times.json")
+scan_cache_path = Path("plots/scan-cache.json")
+scan_output_dirs = [Path(f"plots/{d}") for d in ("scanner", "par", "cl", "columns", "preview", "multistart")]
+scan_columns_version = 1  # see include/ScanColumns.h
 
 
 # CharmFitter scans and plotting ---------------------------------------------------------------------------------------
@@ -308,6 +316,7 @@ class Plotter:
     fopts: list[Any] = field(default_factory=list)
     mopts: list[Any] = field(default_factory=list)
     extensions: list[str] = field(default_factory=_default_extensions)
+    preview: bool = False  # read the Gaussian approximations of the scans written with `--preview`
 
     def add_scan(
         self,
@@ -322,7 +331,7 @@ class Plotter:
         marker=None,
     ):
         if scanname is not None:
-            x, y, z, pt = get_scan_res(scanname, *pars)
+            x, y, z, pt = get_scan_res(scanname, *pars, preview=self.preview)
 
             if self.xtransf is not None:
                 x = self.xtransf(x)
@@ -349,6 +358,8 @@ class Plotter:
             self.scanpoints.append([x, y, z])
 
         # label
+        if self.preview and label:
+            label += " (Gaussian approx.)"
         self.legtitles.append(label)
 
         # 1d opts
@@ -631,6 +642,66 @@ def getfnames(prefix: str, xpar: str, ypar: str | None = None):
     return fname, bfname
 
 
+@dataclass(frozen=True)
+class ScanColumns:
+    """Columnar copy of a scanner ROOT file, written by the executables (see include/ScanColumns.h).
+
+    The arrays are memory-mapped, and bit-by-bit identical to the content of the ROOT file.
+    """
+
+    x: np.ndarray  # bin centres of the first scanned variable
+    y: np.ndarray | None  # bin centres of the second scanned variable (None for 1D scans)
+    cl: np.ndarray  # 1 - CL, with shape (nx,) or (nx, ny)
+    chi2min: np.ndarray  # minimum chi2, with the same shape as cl
+    solutions: np.ndarray  # floating parameters at the local minima, with shape (n_solutions, n_parameters)
+    meta: dict[str, Any]
+    # Side table saved with `--save-nuisances` (None otherwise), of which the scans of `--derived` save the status
+    nuisances: np.ndarray | None = None  # all parameters at each scan point, with shape cl.shape + (n_parameters,)
+    chi2: np.ndarray | None = None  # chi2 of the refit at each scan point, comparable to chi2min
+    status: np.ndarray | None = None  # Minuit2 status of the refit at each scan point (0 if converged)
+    ncalls: np.ndarray | None = None  # number of chi2 evaluations of the refit at each scan point
+
+    @property
+    def dchi2(self) -> np.ndarray:
+        """Chi2 relative to its minimum over the scan."""
+        return self.chi2min - np.min(self.chi2min)
+
+    def solution(self, i: int = 0) -> dict[str, float]:
+        """Values of the floating parameters at the i-th local minimum."""
+        return dict(zip(self.meta["parameters"], self.solutions[i], strict=True))
+
+    def profile(self, par: str) -> np.ndarray:
+        """Profiled values of a parameter at each scan point, with the same shape as cl."""
+        if self.nuisances is None:
+            raise ValueError("The scan was run without --save-nuisances")
+        return self.nuisances[..., self.meta["nuisance_parameters"].index(par)]
+
+
+def read_scan_columns(prefix: str, xpar: str, ypar: str | None = None) -> ScanColumns:
+    """Read the columnar copy of the scanner file returned by `getfnames`, without ROOT."""
+    yext = f"_{ypar}" if ypar is not None else ""
+    path = Path(f"plots/columns/{prefix}_{xpar}{yext}")
+    if not (path / "meta.json").exists():
+        raise FileNotFoundError(f"Cannot find columnar scan {str(path)!r}")
+    with open(path / "meta.json") as f:
+        meta = json.load(f)
+    if meta["version"] != scan_columns_version:
+        raise ValueError(f"Unsupported version {meta['version']} of columnar scan {str(path)!r}")
+
+    def load(name: str) -> np.ndarray:
+        return np.load(path / f"{name}.npy", mmap_mode="r")
+
+    return ScanColumns(
+        x=load("x"),
+        y=load("y") if meta["dimension"] == 2 else None,
+        cl=load("cl"),
+        chi2min=load("chi2min"),
+        solutions=load("solutions"),
+        meta=meta,
+        **{name: load(name) for name in ("nuisances", "chi2", "status", "ncalls") if name in meta["columns"]},
+    )
+
+
 def print_cl(prefix: str, xpar: str, prob: bool = True):
     pref = prefix.split("scanner")[1]
     suff = "Prob" if prob else "Plugin"
@@ -644,7 +715,10 @@ def print_cl(prefix: str, xpar: str, prob: bool = True):
         return
 
 
-def get_scan_res(prefix: str, xpar: str, ypar: str | None = None):
+def get_scan_res(prefix: str, xpar: str, ypar: str | None = None, preview: bool = False):
+    if preview:
+        return get_preview_res(prefix, xpar, ypar)
+
     pars = [xpar]
     if ypar is not None:
         pars.append(ypar)
@@ -660,6 +734,19 @@ def get_scan_res(prefix: str, xpar: str, ypar: str | None = None):
     return read_gc_scan(fname, bfname, pars)
 
 
+def get_preview_res(prefix: str, xpar: str, ypar: str | None = None):
+    """Read the Gaussian approximation of a scan written by `charm-combo --preview` (see include/Impact.h).
+
+    The results have the same layout as those of `get_scan_res`.
+    """
+    scan = read_scan_columns(prefix.replace("_scanner", "_preview"), xpar, ypar)
+    solution = scan.solution()
+    print(f"{prefix} - {xpar}" + (f" , {ypar}" if ypar is not None else "") + " (Gaussian approximation)")
+    if ypar is None:
+        return np.array(scan.x), np.array(scan.cl), None, [solution[xpar]]
+    return np.array(scan.x), np.array(scan.y), np.array(scan.cl).T, [solution[xpar], solution[ypar]]
+
+
 def _combiner_string(id: int | list[int]) -> str:
     """Get the cobiner string to be used by the combination executable."""
     if isinstance(id, int):
@@ -672,6 +759,28 @@ def _combiner_file_string(pdf_ids: list[int]):
     return "empty+" + "+".join([str(pdf_id) for pdf_id in sorted(pdf_ids)])
 
 
+def _multistart_seed(
+    args: argparse.Namespace, combiner_id: str, combiner: Combiner, prefix: str, opts: str
+) -> tuple[str, str]:
+    """Get the command fitting a combiner from `args.multistart` start points drawn with `args.multistart_seed`, and
+    the start file that it writes.
+
+    Args:
+        prefix: Prefix of the scanner files of the scans seeded by the fit (see `_get_prefix`).
+        opts: Options of the scans selecting the parametrisation and the fixed parameters.
+    """
+    combiner_arg = combiner_id if isinstance(combiner.id, int) else _combiner_file_string(combiner.id)
+    parfile = (
+        f"plots/multistart/{prefix.replace('_scanner', '')}_{combiner_arg}"
+        f"_{args.multistart}starts_seed{args.multistart_seed}.dat"
+    )
+    command = (
+        f"bin/{args.execfile} -c {_combiner_string(combiner.id)} --multistart {args.multistart}"
+        f" --multistart-seed {args.multistart_seed} {opts}"
+    )
+    return command, parfile
+
+
 def _viable_acp_params(xpar: Parameter, ypar: Parameter | None = None) -> list[AcpParam]:
     """Get the aCP(h- h+) parametrisations that are usable for the given parameter(s)."""
     return [
@@ -770,18 +879,22 @@ def _dcs_cpv_subdir(args: argparse.Namespace, compare_dcs_hypos: bool) -> str:
 def scans_1d(args: argparse.Namespace, cfg: ModuleType, combiners_ids: list[str] | None = None) -> None:
     """Run the 1D scans for all parameters."""
 
-    if not (args.rescan or args.plugin):
+    if not (args.rescan or args.plugin or args.preview):
         return
     if combiners_ids is None:
         combiners_ids = cfg.baseline_combiners
 
     cmds = []
+    seeds = []
     for par in cfg.parameters.values():
         if not par.scan_1d or (par.name == "Acp_KP" and not args.dcs_cpv):
             continue
         extra_opts = args.extra_opts
         if MixParam.PHENO in par.mix_params and MixParam.THEO not in par.mix_params:
             extra_opts += " --mix pheno"
+        variant_opts = extra_opts
+        if args.preview:
+            extra_opts += " --preview"
         if args.plugin:
             if args.submit:
                 extra_opts += f" -a pluginbatch --ntoys 50 --nbatchjobs 200 {args.batchopts}"
@@ -795,25 +908,32 @@ def scans_1d(args: argparse.Namespace, cfg: ModuleType, combiners_ids: list[str]
                 f" --var {par.name:<12s}"
                 f" --scanrange {scan_range[0]}:{scan_range[1]} {extra_opts}"
             )
+            if args.multistart:
+                prefix = _get_prefix(args.prefix, par, dcs_cpv=args.dcs_cpv)
+                seed, parfile = _multistart_seed(args, combiner_id, cfg.combiners[combiner_id], prefix, variant_opts)
+                seeds.append(seed)
+                cmd += f" --parfile {parfile}"
             cmds.append(cmd)
 
+    run_scans(args, list(dict.fromkeys(seeds)), threads=os.cpu_count() or 1)  # the fits of each seed run in parallel
     if args.plugin and args.submit:
         for cmd in cmds:
             run_command(cmd)
         return
     else:
-        run_commands(cmds)
+        run_scans(args, cmds)
 
 
 def scans_2d(args: argparse.Namespace, cfg: ModuleType, plots_2d: list[Plot2D] | None = None) -> None:
     """Run the 2D scans for all parameters."""
 
-    if not args.rescan:
+    if not (args.rescan or args.preview):
         return
     if plots_2d is None:
         plots_2d = cfg.plots_2d
 
     cmds = []
+    seeds = []
     for plot_params in plots_2d:
         if plot_params.scan is False:
             continue
@@ -830,6 +950,11 @@ def scans_2d(args: argparse.Namespace, cfg: ModuleType, plots_2d: list[Plot2D] |
                 for params in [xpar.mix_params, ypar.mix_params]
             ) or (scanparams is not None and scanparams.mix_param == MixParam.PHENO):
                 extra_opts += " --mix pheno"
+            if scanparams is not None:
+                extra_opts += f" {scanparams.extra_opts}"
+            variant_opts = extra_opts
+            if args.preview:
+                extra_opts += " --preview"
             xrange = (
                 scanparams.xrange
                 if scanparams is not None
@@ -844,8 +969,19 @@ def scans_2d(args: argparse.Namespace, cfg: ModuleType, plots_2d: list[Plot2D] |
                 if plot_params.yrange is not None
                 else ypar.scan_range_2d
             )
+            if args.multistart:
+                prefix = _get_prefix(
+                    args.prefix,
+                    xpar,
+                    ypar,
+                    dy_fsc=cfg.dy_fsc_baseline if hasattr(cfg, "dy_fsc_baseline") else None,
+                    mix=scanparams.mix_param if scanparams is not None else None,
+                    dcs_cpv=args.dcs_cpv,
+                )
+                seed, parfile = _multistart_seed(args, combiner_id, cfg.combiners[combiner_id], prefix, variant_opts)
+                seeds.append(seed)
+                extra_opts += f" --parfile {parfile}"
             if scanparams is not None:
-                extra_opts += f" {scanparams.extra_opts}"
                 if scanparams.fixed_pars:
                     pars_string = ",".join(scanparams.fixed_pars)
                     extra_opts += f" --fix-from-parfile {pars_string} --fix-parfile {cfg.baseline_parfile}"
@@ -861,7 +997,7 @@ def scans_2d(args: argparse.Namespace, cfg: ModuleType, plots_2d: list[Plot2D] |
                             dcs_cpv=args.dcs_cpv if hasattr(args, "dcs_cpv") else None,
                         ).replace("_scanner", "")
                         parfile = f"plots/par/{prefix}_{cfg.baseline_combiner}_{xpar.name}.dat"
-                if parfile is not None and Path(parfile).is_file():
+                if parfile is not None and Path(parfile).is_file() and not args.multistart:
                     extra_opts += f" --parfile {parfile}"
             cmd = (
                 f"bin/{args.execfile} -c {_combiner_string(cfg.combiners[combiner_id].id):<31s}"
@@ -871,7 +1007,8 @@ def scans_2d(args: argparse.Namespace, cfg: ModuleType, plots_2d: list[Plot2D] |
                 f" {extra_opts}"
             )
             cmds.append(cmd)
-    run_commands(cmds)
+    run_scans(args, list(dict.fromkeys(seeds)), threads=os.cpu_count() or 1)  # the fits of each seed run in parallel
+    run_scans(args, cmds, threads=args.threads_2d)
 
 
 def compare_dy_fsc_hypotheses_scans_2d(
@@ -882,7 +1019,7 @@ def compare_dy_fsc_hypotheses_scans_2d(
 ) -> None:
     """Run the 2D scans for different hypotheses for the final-state dependence of DeltaY(h- h+)."""
 
-    if not args.rescan:
+    if not (args.rescan or args.preview):
         return
     if combiners_ids is None:
         combiners_ids = cfg.baseline_combiners
@@ -893,30 +1030,37 @@ def compare_dy_fsc_hypotheses_scans_2d(
             continue
         xname, yname = plot_params.params
         xpar, ypar = cfg.parameters[xname], cfg.parameters[yname]
-        for dy_fsc in dy_fscs:
-            if dy_fsc == DYFsc.NONE or any(dy_fsc not in params for params in [xpar.dy_fsc_hypos, ypar.dy_fsc_hypos]):
-                continue
-            extra_opts = args.extra_opts
-            if any(MixParam.THEO not in params for params in [xpar.mix_params, ypar.mix_params]):
-                extra_opts += " --mix pheno"
-            extra_opts += f" --dy-fsc {dy_fsc.value}"
-            acp_param = _pick_acp_param(_viable_acp_params(xpar, ypar))
-            if acp_param is None:
-                raise ValueError(f"Cannot find a viable acp_param for {xpar.name} and {ypar.name}")
-            if acp_param != AcpParam.ACP_DY:
-                extra_opts += f" --acp {acp_param.value}"
-            for combiner_id in combiners_ids:
-                xrange = plot_params.xrange if plot_params.xrange is not None else xpar.scan_range_2d
-                yrange = plot_params.yrange if plot_params.yrange is not None else ypar.scan_range_2d
-                cmd = (
-                    f"bin/{args.execfile} -c {cfg.combiners[combiner_id].id}"
-                    f" --var {xpar.name:<7s} --var {ypar.name:<7s}"
-                    f" --scanrange  {xrange[0]}:{xrange[1]}"
-                    f" --scanrangey {yrange[0]}:{yrange[1]}"
-                    f" {extra_opts}"
-                )
-                cmds.append(cmd)
-    run_commands(cmds)
+        # All hypotheses are run by a single process, which builds the hypothesis-independent PDFs only once
+        viable_dy_fscs = [
+            dy_fsc
+            for dy_fsc in dy_fscs
+            if dy_fsc != DYFsc.NONE and all(dy_fsc in params for params in [xpar.dy_fsc_hypos, ypar.dy_fsc_hypos])
+        ]
+        if not viable_dy_fscs:
+            continue
+        extra_opts = args.extra_opts
+        if args.preview:
+            extra_opts += " --preview"
+        if any(MixParam.THEO not in params for params in [xpar.mix_params, ypar.mix_params]):
+            extra_opts += " --mix pheno"
+        extra_opts += " --dy-fsc " + ",".join(dy_fsc.value for dy_fsc in viable_dy_fscs)
+        acp_param = _pick_acp_param(_viable_acp_params(xpar, ypar))
+        if acp_param is None:
+            raise ValueError(f"Cannot find a viable acp_param for {xpar.name} and {ypar.name}")
+        if acp_param != AcpParam.ACP_DY:
+            extra_opts += f" --acp {acp_param.value}"
+        for combiner_id in combiners_ids:
+            xrange = plot_params.xrange if plot_params.xrange is not None else xpar.scan_range_2d
+            yrange = plot_params.yrange if plot_params.yrange is not None else ypar.scan_range_2d
+            cmd = (
+                f"bin/{args.execfile} -c {cfg.combiners[combiner_id].id}"
+                f" --var {xpar.name:<7s} --var {ypar.name:<7s}"
+                f" --scanrange  {xrange[0]}:{xrange[1]}"
+                f" --scanrangey {yrange[0]}:{yrange[1]}"
+                f" {extra_opts}"
+            )
+            cmds.append(cmd)
+    run_scans(args, cmds, threads=args.threads_2d)
 
 
 def plots_1d(
@@ -946,6 +1090,7 @@ def plots_1d(
 
         plot = Plotter(
             dim=1,
+            preview=args.preview,
             save=args.savedir / combiners_label / "1d" / _dcs_cpv_subdir(args, compare_dcs_hypos) / f"{parname}.pdf",
             xtitle=par.title,
             xrange=par.plot_range,
@@ -1023,6 +1168,7 @@ def plots_2d(
 
         plot = Plotter(
             dim=2,
+            preview=args.preview,
             save=args.savedir
             / (cfg.baseline_combiner if breakdown else combiners_label)
             / ("breakdown" if breakdown else "2d")
@@ -1130,6 +1276,7 @@ def compare_dy_fsc_hypotheses_plots_2d(
         for combiner_id in combiners_ids:
             plot = Plotter(
                 dim=2,
+                preview=args.preview,
                 save=args.savedir
                 / combiner_id
                 / "dy-fsc-comparisons"
@@ -1195,6 +1342,13 @@ def parse_args(*, combo: str = "charm", dcs_cpv_default: bool = False) -> argpar
     parser.add_argument(
         "-r", "--rescan", default=False, action="store_true", help="Rerun the scans (rather than just make plots)"
     )
+    parser.add_argument(
+        "-f",
+        "--force",
+        default=False,
+        action="store_true",
+        help="With --rescan, rerun also the scans whose inputs did not change since their last run",
+    )
     parser.add_argument(
         "--config",
         type=Path,
@@ -1222,7 +1376,39 @@ def parse_args(*, combo: str = "charm", dcs_cpv_default: bool = False) -> argpar
         "-i", "--interactive", default=False, action="store_true", help="Show plots interactively at the end"
     )
     parser.add_argument("-v", "--verbose", default=False, action="store_true", help="Verbose output of scan commands")
+    parser.add_argument(
+        "-j", "--jobs", type=int, default=None, help="Number of cores used to run the scans (default: all)"
+    )
+    parser.add_argument(
+        "--threads-2d",
+        type=int,
+        default=None,
+        help="Number of cores reserved for each 2D scan (default: its CPU time over its wall time in the last run)",
+    )
     parser.add_argument("-P", "--plugin", default=False, action="store_true", help="Use plugin scans")
+    parser.set_defaults(preview=False, multistart=0, multistart_seed=1)
+    if combo == "charm":
+        parser.add_argument(
+            "--multistart",
+            type=int,
+            default=0,
+            metavar="N",
+            help="Seed the scans with the minima found by fitting each combiner from N start points",
+        )
+        parser.add_argument(
+            "--multistart-seed",
+            type=int,
+            default=1,
+            metavar="SEED",
+            help="Seed of the random start points of --multistart (default: 1)",
+        )
+        parser.add_argument(
+            "--preview",
+            default=False,
+            action="store_true",
+            help="Replace the scans with their Gaussian approximations from the HESSE matrix at the global minimum,\n"
+            "which take seconds, and plot them in <savedir>/preview",
+        )
     parser.add_argument("-S", "--submit", default=False, action="store_true", help="Submit plugin batch jobs")
     parser.add_argument(
         "-B",
@@ -1255,6 +1441,8 @@ def parse_args(*, combo: str = "charm", dcs_cpv_default: bool = False) -> argpar
             + ("" if dcs_cpv_default else " (default)"),
         )
     args = parser.parse_args()
+    if args.preview and args.plugin:
+        parser.error("--preview cannot be used with --plugin")
     args.dcs_cpv_default = dcs_cpv_default
     if combo != "ws" and args.dcs_cpv:
         args.extra_opts += " --dcs-cpv"
@@ -1262,6 +1450,8 @@ def parse_args(*, combo: str = "charm", dcs_cpv_default: bool = False) -> argpar
         args.config = repo_path / args.config
     if not args.savedir.is_absolute():
         args.savedir = repo_path / args.savedir
+    if args.preview:
+        args.savedir /= "preview"
     return args
 
 
@@ -1333,10 +1523,357 @@ def run_command(cmd: str | list[str], verbose: bool = False, shell: bool = True)
     return subprocess.run(cmd, shell=shell, capture_output=not verbose, check=True)
 
 
-def run_commands(cmds: list[str]) -> list[subprocess.CompletedProcess[bytes]]:
-    """Run a list of commands in parallel via subprocess."""
-    pool = Pool()
-    return pool.map(run_command, cmds)
+@dataclass
+class _Job:
+    """A command scheduled by `run_commands`, with its estimated cost and the number of cores it reserves."""
+
+    index: int
+    cmd: str
+    cost: float
+    threads: int
+    start: float = 0.0
+    end: float = 0.0
+    after: "_Job | None" = None  # the job whose end freed the cores this job was started on
+
+
+def _history_key(cmd: str) -> str:
+    """Normalise a command, so that differences in the whitespace padding do not change its history entry."""
+    return " ".join(cmd.split())
+
+
+def _load_history(history: Path) -> tuple[dict[str, float], dict[str, float]]:
+    """Read the wall times and the CPU times (including those of the child processes) of the commands.
+
+    Each entry is either the wall time alone (as written before the CPU times were recorded) or both.
+    """
+    if not history.is_file():
+        return {}, {}
+    try:
+        with open(history) as f:
+            entries = json.load(f)
+    except (OSError, json.JSONDecodeError):
+        print(f"WARNING Cannot read the wall-time history {str(history)!r}, ignoring it")
+        return {}, {}
+    times = {key: entry["wall"] if isinstance(entry, dict) else entry for key, entry in entries.items()}
+    cpu_times = {key: entry["cpu"] for key, entry in entries.items() if isinstance(entry, dict)}
+    return times, cpu_times
+
+
+def _estimate_cost(cmd: str, times: dict[str, float]) -> float:
+    """Estimate the wall time of a command from the history.
+
+    Commands that never ran are assigned the largest known time of the commands with the same number of scanned
+    variables (or of any command, if there are none), so that they are started early rather than ending up in the tail.
+    """
+    key = _history_key(cmd)
+    if key in times:
+        return times[key]
+    nvars = key.count("--var ")
+    similar = [t for k, t in times.items() if k.count("--var ") == nvars] or list(times.values())
+    return max(similar, default=float(nvars))
+
+
+def _estimate_threads(cmd: str, times: dict[str, float], cpu_times: dict[str, float]) -> int:
+    """Estimate the number of cores a command keeps busy, as its CPU time over its wall time in the history.
+
+    Commands that never ran are assigned the largest estimate of the commands with the same number of scanned variables
+    (or 1, if there are none), as in `_estimate_cost`.
+    """
+
+    def threads(key: str) -> int:
+        return max(1, round(cpu_times[key] / times[key])) if times[key] > 0 else 1
+
+    key = _history_key(cmd)
+    if key in cpu_times:
+        return threads(key)
+    nvars = key.count("--var ")
+    return max((threads(k) for k in cpu_times if k.count("--var ") == nvars), default=1)
+
+
+def _reap(proc: subprocess.Popen) -> float | None:
+    """Reap a command that ended and return its CPU time, including that of its child processes, or None if it runs."""
+    pid, status, usage = os.wait4(proc.pid, os.WNOHANG)
+    if pid == 0:
+        return None
+    proc.returncode = os.waitstatus_to_exitcode(status)
+    return usage.ru_utime + usage.ru_stime
+
+
+def _report_schedule(jobs: list[_Job], ncores: int) -> None:
+    """Print the wall time of a schedule, its lower bound and its critical path.
+
+    The commands are independent, hence the critical path is the chain of commands that ends with the last one to
+    finish, where each command was started on the cores freed by the previous one. The wall time cannot be shorter
+    than either the longest command or the total CPU time divided by the number of cores.
+    """
+    last = max(jobs, key=lambda job: job.end)
+    longest = max(job.end - job.start for job in jobs)
+    lower_bound = max(longest, sum(job.threads * (job.end - job.start) for job in jobs) / ncores)
+    print(
+        f"INFO Ran {len(jobs)} commands on {ncores} cores in {last.end:.0f} s"
+        f" (lower bound {lower_bound:.0f} s, longest command {longest:.0f} s)"
+    )
+    path = []
+    job = last
+    while job is not None:
+        path.append(job)
+        job = job.after
+    print("INFO Critical path:")
+    for job in reversed(path):
+        print(f"     {job.start:7.0f} s -> {job.end:7.0f} s  {_history_key(job.cmd)}")
+
+
+def run_commands(
+    cmds: list[str],
+    *,
+    jobs: int | None = None,
+    threads: int | Callable[[str], int] | None = 1,
+    history: Path | None = scan_history_path,
+    verbose: bool = False,
+    on_start: Callable[[str], None] | None = None,
+    on_success: Callable[[str], None] | None = None,
+) -> list[subprocess.CompletedProcess[bytes]]:
+    """Run a list of commands in parallel via subprocess.
+
+    The commands are started longest-first from a work queue, using the wall times of previous runs stored in
+    `history`, which is updated at the end. Each command reserves `threads` cores (the value is also exported to it as
+    OMP_NUM_THREADS), and the next command in the queue that fits in the free cores is started as soon as one ends.
+    The history also records the CPU time of each command, from which the cores it keeps busy are estimated.
+
+    Args:
+        jobs: Number of cores to use (default: all).
+        threads: Number of cores reserved per command, or a function returning it for a given command, or None to
+            estimate it from the history (see `_estimate_threads`).
+        history: JSON file with the wall time of each command (None to disable).
+        verbose: Print the output of the commands instead of capturing it.
+        on_start: Function called with each command just before it starts.
+        on_success: Function called with each command that succeeds, as soon as it ends.
+
+    Raises:
+        subprocess.CalledProcessError: If any of the commands fails (after all other commands have finished).
+    """
+    if not cmds:
+        return []
+    ncores = jobs or os.cpu_count() or 1
+    times, cpu_times = _load_history(history) if history is not None else ({}, {})
+
+    def reserved(cmd: str) -> int:
+        if threads is None:
+            return _estimate_threads(cmd, times, cpu_times)
+        return threads(cmd) if callable(threads) else threads
+
+    queue = [
+        _Job(i, cmd, _estimate_cost(cmd, times), min(ncores, max(1, reserved(cmd)))) for i, cmd in enumerate(cmds)
+    ]
+    queue.sort(key=lambda job: job.cost, reverse=True)
+
+    done: list[_Job] = []
+    results: list[subprocess.CompletedProcess[bytes] | None] = [None] * len(cmds)
+    failures = []
+    running = []
+    free_cores = ncores
+    last_done = None
+    t0 = time.monotonic()
+    while queue or running:
+        # Start the most expensive commands that fit in the free cores
+        while (job := next((job for job in queue if job.threads <= free_cores), None)) is not None:
+            queue.remove(job)
+            free_cores -= job.threads
+            job.start, job.after = time.monotonic() - t0, last_done
+            print(f"Running: {job.cmd!r}")
+            if on_start is not None:
+                on_start(job.cmd)
+            out = None if verbose else tempfile.TemporaryFile()
+            env = dict(os.environ, OMP_NUM_THREADS=str(job.threads))
+            running.append((job, subprocess.Popen(job.cmd, shell=True, stdout=out, stderr=out, env=env), out))
+
+        time.sleep(0.1)
+        for job, proc, out in list(running):
+            cpu_time = _reap(proc)
+            if cpu_time is None:
+                continue
+            running.remove((job, proc, out))
+            job.end = time.monotonic() - t0
+            free_cores += job.threads
+            last_done = job
+            done.append(job)
+            output = b""
+            if out is not None:
+                out.seek(0)
+                output = out.read()
+                out.close()
+            results[job.index] = subprocess.CompletedProcess(job.cmd, proc.returncode, output, b"")
+            if proc.returncode != 0:
+                print(f"ERROR Command {job.cmd!r} failed with exit code {proc.returncode}")
+                failures.append(subprocess.CalledProcessError(proc.returncode, job.cmd, output))
+            else:
+                times[_history_key(job.cmd)] = job.end - job.start
+                cpu_times[_history_key(job.cmd)] = cpu_time
+                if on_success is not None:
+                    on_success(job.cmd)
+
+    _report_schedule(done, ncores)
+    if history is not None:
+        history.parent.mkdir(parents=True, exist_ok=True)
+        entries = {
+            key: {"wall": wall, "cpu": cpu_times[key]} if key in cpu_times else wall for key, wall in times.items()
+        }
+        with open(history, "w") as f:
+            json.dump(entries, f, indent=1, sort_keys=True)
+    if failures:
+        raise failures[0]
+    return results
+
+
+def _file_digest(path: Path) -> str:
+    """SHA-256 of the contents of a file, or "missing" if it does not exist."""
+    return hashlib.sha256(path.read_bytes()).hexdigest() if path.is_file() else "missing"
+
+
+class ScanCache:
+    """Content-addressed cache of the scan results.
+
+    Each scan command is keyed by a hash of the command itself (scanned variables, ranges and all options, including
+    the parametrisation flags), of the contents of the executable and of the start parameter files it reads (options
+    `--parfile` and `--fix-parfile`), and of the fingerprints of the PDFs entering the combiner, which the executable
+    prints when run with `--fingerprint` (see include/ScanCache.h). These include the measured values, uncertainties,
+    correlations and theory expressions of each PDF, as well as the build id of the libraries holding the fit.
+    A scan is skipped if its key matches the one stored after its last successful run, and the files it wrote then
+    still exist.
+
+    The files written by a command are those in `scan_output_dirs` modified while it ran, whose names contain all the
+    variables it scans. They may include the files of other commands running at the same time, which can only cause a
+    scan to be rerun when it was not needed.
+
+    Args:
+        execfile: Name of the executable in bin/.
+        path: JSON file mapping each command to the key of its last successful run and the files it wrote.
+    """
+
+    def __init__(self, execfile: str, path: Path = scan_cache_path):
+        self.execfile = execfile
+        self.path = path
+        self.keys: dict[str, str] = {}
+        self.started: dict[str, float] = {}
+        self.stored: dict[str, dict[str, Any]] = {}
+        self.fingerprints: dict[str, dict[str, dict[int, str]]] = {}
+        self.executable_digest = _file_digest(Path("bin") / execfile)
+        if path.is_file():
+            with open(path) as f:
+                self.stored = json.load(f)
+
+    def _get_fingerprints(self, variant_opts: str) -> dict[str, dict[int, str]]:
+        """Run the executable with `--fingerprint` once per set of parametrisation flags."""
+        if variant_opts not in self.fingerprints:
+            res = subprocess.run(
+                f"bin/{self.execfile} --fingerprint {variant_opts}", shell=True, capture_output=True, check=True
+            )
+            fingerprints: dict[str, dict[int, str]] = {"version": {}, "pdf": {}, "combiner": {}}
+            for line in res.stdout.decode().splitlines():
+                if not line.startswith("FINGERPRINT "):
+                    continue
+                _, engine, kind, value = line.split(" ", 3)
+                id, _, text = value.partition(" ") if kind != "version" else (0, "", value)
+                entry = fingerprints[kind].setdefault(int(id), "")
+                fingerprints[kind][int(id)] = entry + f"{engine}:{text}\n"
+            self.fingerprints[variant_opts] = fingerprints
+        return self.fingerprints[variant_opts]
+
+    def key(self, cmd: str) -> str:
+        """Hash of the inputs of a scan command."""
+        cmd = _history_key(cmd)
+        variant_opts = " ".join(re.findall(r"--(?:mix|dy-fsc|acp) \S+|--dcs-cpv", cmd))
+        fingerprints = self._get_fingerprints(variant_opts)
+        combiner = re.search(r"(?:^|\s)-c (\S+)", cmd).group(1)
+        if combiner.isdigit():
+            # One line per engine, in the form `<engine>:<comma-separated PDF ids>`
+            pdf_ids = {
+                int(i)
+                for line in fingerprints["combiner"][int(combiner)].splitlines()
+                for i in line.split(":", 1)[1].split(",")
+                if i
+            }
+        else:
+            pdf_ids = {int(i) for i in re.findall(r"\+(\d+)", combiner)}
+        sha = hashlib.sha256(cmd.encode())
+        sha.update(self.executable_digest.encode())
+        sha.update(fingerprints["version"][0].encode())
+        for parfile in re.findall(r"--(?:fix-)?parfile (\S+)", cmd):
+            sha.update(_file_digest(Path(parfile)).encode())
+        for pdf_id in sorted(pdf_ids):
+            sha.update(fingerprints["pdf"][pdf_id].encode())
+        return sha.hexdigest()
+
+    def up_to_date(self, cmd: str) -> bool:
+        """Whether the inputs of a command did not change since its last successful run, and its outputs still exist.
+
+        Entries without outputs (e.g. those written by older versions of the cache) are never up to date.
+        """
+        entry = self.stored.get(_history_key(cmd))
+        if not isinstance(entry, dict) or entry.get("key") != self.keys[cmd]:
+            return False
+        return bool(entry.get("outputs")) and all(Path(output).exists() for output in entry["outputs"])
+
+    def filter(self, cmds: list[str], force: bool = False) -> list[str]:
+        """Return the commands whose inputs changed or whose outputs are missing (all of them, if `force`)."""
+        outdated = []
+        for cmd in cmds:
+            self.keys[cmd] = self.key(cmd)
+            if not force and self.up_to_date(cmd):
+                print(f"Up to date: {cmd!r}")
+            else:
+                outdated.append(cmd)
+        return outdated
+
+    def start(self, cmd: str) -> None:
+        """Record the start of a command, to find the files it writes."""
+        self.started[cmd] = time.time()
+
+    def outputs(self, cmd: str) -> list[str]:
+        """Files and directories in `scan_output_dirs` modified since the start of a command, named after its variables.
+
+        The modification time of a directory is that of the latest file in it.
+        """
+        variables = re.findall(r"--var (\S+)", cmd)
+        # Allow for the resolution of the modification times of the file system
+        since = self.started.get(cmd, 0.0) - 2.0
+        outputs = []
+        for directory in scan_output_dirs:
+            if not directory.is_dir():
+                continue
+            for path in sorted(directory.iterdir()):
+                if not all(re.search(rf"(?:^|_){re.escape(var)}(?:_|\.|$)", path.name) for var in variables):
+                    continue
+                files = [f for f in path.rglob("*") if f.is_file()] if path.is_dir() else [path]
+                if any(f.stat().st_mtime >= since for f in files):
+                    outputs.append(str(path))
+        return outputs
+
+    def store(self, cmd: str) -> None:
+        """Record a successful run of a command with the files it wrote, and save the cache."""
+        self.stored[_history_key(cmd)] = {
+            "key": self.keys[cmd] if cmd in self.keys else self.key(cmd),
+            "outputs": self.outputs(cmd),
+        }
+        self.path.parent.mkdir(parents=True, exist_ok=True)
+        with open(self.path, "w") as f:
+            json.dump(self.stored, f, indent=1, sort_keys=True)
+
+
+def run_scans(args: argparse.Namespace, cmds: list[str], **kwargs) -> None:
+    """Run the scan commands that are not up to date in the scan cache (all of them, with `--force`).
+
+    The forced scans are stored in the cache, too.
+    """
+    cache = ScanCache(args.execfile)
+    run_commands(
+        cache.filter(cmds, force=args.force),
+        jobs=args.jobs,
+        verbose=args.verbose,
+        on_start=cache.start,
+        on_success=cache.store,
+        **kwargs,
+    )
 
 
 def setup_matplotlib(*, style="lhcb", usetex: bool = True) -> None: